@@ -0,0 +1,113 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include "alarmpat.h"
+
+/* about 33ms per frame */
+const xAlarmStep ap_blink[] PROGMEM = {
+	{255, 15, 0}, {0, 15, 0}, {0, 0, 0}
+};
+
+const xAlarmStep ap_double_blink[] PROGMEM = {
+	{255, 4, 0}, {0, 4, 0}, {255, 4, 0}, {0, 30, 0}, {0, 0, 0}
+};
+
+const xAlarmStep ap_fade[] PROGMEM = {
+	{255, 45, 1}, {0, 45, 1}, {0, 0, 0}
+};
+
+/* gradual wake: a slow ramp to full over about 40s, then blink until dismissed */
+const xAlarmStep ap_wake[] PROGMEM = {
+	{0, 1, 0}, {32, 240, 1}, {96, 240, 1}, {176, 240, 1}, {255, 240, 1}, {255, 240, 0},
+	{255, 15, 0}, {0, 15, 0}, {255, 15, 0}, {0, 15, 0}, {255, 15, 0}, {0, 15, 0}, {0, 0, 0}
+};
+
+static const xAlarmStep *ap_pattern; // start of the pattern playing, 0 if stopped
+static const xAlarmStep *ap_step; // next step to load
+static uint16_t ap_level; // brightness, 8.8 fixed point
+static int16_t ap_inc; // added to ap_level every frame while ramping
+static uint8_t ap_target;
+static uint8_t ap_left; // frames left in this step
+static uint8_t ap_div;
+
+void alarmpat_init(void) {
+	DDRB |= 0xFF;
+	PORTB = 0x00;
+	OCR3A = 0;
+	OCR3B = 0;
+	TCCR3A = (1 << WGM30); // fast PWM, 8 bit, outputs connected on play
+	TCCR3B = (1 << WGM32) | (1 << CS31) | (1 << CS30); // clk / 64
+}
+
+void alarmpat_play(const xAlarmStep *pattern) {
+	uint8_t sreg = SREG;
+	cli();
+	ap_pattern = pattern;
+	ap_step = pattern;
+	ap_level = 0;
+	ap_inc = 0;
+	ap_left = 0;
+	ap_div = 0;
+	TCCR3A |= (1 << COM3A1) | (1 << COM3B1); // non-inverting PWM on PB6 and PB7
+	TIFR3 = (1 << TOV3);
+	TIMSK3 |= (1 << TOIE3);
+	SREG = sreg;
+}
+
+void alarmpat_stop(void) {
+	uint8_t sreg = SREG;
+	cli();
+	TIMSK3 &= ~(1 << TOIE3);
+	TCCR3A &= ~((1 << COM3A1) | (1 << COM3B1));
+	ap_pattern = 0;
+	PORTB = 0x00;
+	SREG = sreg;
+}
+
+uint8_t alarmpat_playing(void) {
+	return (TIMSK3 & (1 << TOIE3)) ? 1 : 0;
+}
+
+/* Runs at the PWM rate, does real work once a frame. A frame loads at most
+one step, so the cost is bounded: one 32 bit divide when a ramp starts,
+otherwise an add and a multiply. */
+ISR(TIMER3_OVF_vect) {
+	uint8_t level, duty, frames;
+
+	if(++ap_div < AP_FRAME_DIV) {
+		return;
+	}
+	ap_div = 0;
+
+	if(ap_left == 0) {
+		frames = pgm_read_byte(&ap_step->frames);
+		if(frames == 0) { // end, start over
+			ap_step = ap_pattern;
+			frames = pgm_read_byte(&ap_step->frames);
+			if(frames == 0) { // empty pattern
+				return;
+			}
+		}
+		ap_target = pgm_read_byte(&ap_step->level);
+		if(pgm_read_byte(&ap_step->ramp) && frames > 1) { // a one frame ramp is a jump, and would overflow ap_inc
+			ap_inc = (((int32_t)ap_target << 8) - (int32_t)ap_level) / frames;
+		}
+		else {
+			ap_level = (uint16_t)ap_target << 8;
+			ap_inc = 0;
+		}
+		ap_left = frames;
+		ap_step++;
+	}
+
+	ap_level += ap_inc;
+	if(--ap_left == 0) {
+		ap_level = (uint16_t)ap_target << 8; // land exactly, whatever the rounding
+	}
+
+	level = ap_level >> 8;
+	duty = ((uint16_t)level * level) >> 8; // square it, the eye sees brightness roughly that way
+	OCR3A = duty;
+	OCR3B = duty;
+	PORTB = (PORTB & 0xC0) | ((level & 0x80) ? 0x3F : 0x00);
+}
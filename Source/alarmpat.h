@@ -0,0 +1,29 @@
+/* Alarm light patterns, played by Timer3 without any task running */
+#ifndef ALARMPAT_H
+#define ALARMPAT_H
+
+#include <stdint.h>
+
+// PB6 (OC3A) and PB7 (OC3B) get real PWM, PB0-PB5 are switched on while the
+// brightness is at least half.
+
+#define AP_FRAME_DIV 16 // PWM periods per frame, 8MHz / 64 / 256 / 16 is about 30 frames a second
+
+typedef struct {
+	uint8_t level; // brightness 0-255 at the end of the step
+	uint8_t frames; // how long the step lasts, 0 ends the pattern and it starts over
+	uint8_t ramp; // 1 slide from the previous level to level, 0 jump straight to it
+} xAlarmStep;
+
+/* patterns in flash */
+extern const xAlarmStep ap_blink[];
+extern const xAlarmStep ap_double_blink[];
+extern const xAlarmStep ap_fade[];
+extern const xAlarmStep ap_wake[];
+
+void alarmpat_init(void);
+void alarmpat_play(const xAlarmStep *pattern); // loops until alarmpat_stop
+void alarmpat_stop(void); // lights off
+uint8_t alarmpat_playing(void); // Timer3 has to keep running while this is 1
+
+#endif
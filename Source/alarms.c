@@ -0,0 +1,306 @@
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timesvc.h"
+#include "alarms.h"
+
+static xAlarm alarm_table[ALARM_MAX];
+static uint8_t alarm_heap[ALARM_MAX]; // table indexes, earliest key first
+static uint8_t alarm_pos[ALARM_MAX]; // where each table entry is in the heap, 0xFF if not in it
+static uint8_t alarm_count = 0;
+
+/* Local time as of the last alarm_sync. alarm_clock counts local minutes
+from ALARM_CLOCK_BASE at alarm_init, so keys never wrap at the end of the
+week, and it can step back for the end of summer time without going
+below 0. */
+#define ALARM_CLOCK_BASE 0x10000UL
+static uint32_t alarm_clock = ALARM_CLOCK_BASE;
+static uint16_t alarm_mow; // minute of the week, Sunday 00:00 is 0
+static uint8_t alarm_day; // 1-7
+static uint16_t alarm_mod; // minute of the day
+
+/*-------------------------------------------------------------------------*/
+
+static void alarm_sync(void) {
+	xTime t;
+	uint16_t mow;
+	int16_t step;
+
+	timesvc_get(&t);
+	alarm_day = t.day;
+	alarm_mod = (uint16_t)t.hour * 60 + t.min;
+	mow = (uint16_t)(alarm_day - 1) * 1440 + alarm_mod;
+	step = (int16_t)mow - (int16_t)alarm_mow;
+	if(step <= -5040) { // into the next week
+		step += 10080;
+	}
+	else if(step > 5040) { // the clock went back over the start of the week
+		step -= 10080;
+	}
+	alarm_clock += step;
+	alarm_mow = mow;
+}
+
+/* Minutes from now to the next time a's rule matches, at least 1, and sets
+the fire_ fields. Skips one match if skip is set. */
+static uint16_t alarm_delta(xAlarm *a, uint8_t skip) {
+	uint16_t amod = (uint16_t)a->hour * 60 + a->min;
+	uint8_t dd, d;
+
+	for(dd = 0; dd < 15; dd++) {
+		d = alarm_day - 1 + dd;
+		while(d >= 7) {
+			d -= 7;
+		}
+		if(a->days && !(a->days & (1 << d))) {
+			continue;
+		}
+		if(dd == 0 && amod <= alarm_mod) { // already passed today
+			continue;
+		}
+		if(skip) {
+			skip = 0;
+			continue;
+		}
+		a->fire_day = d + 1;
+		a->fire_hour = a->hour;
+		a->fire_min = a->min;
+		return (uint16_t)dd * 1440 + amod - alarm_mod;
+	}
+	return 0; // no day in the mask
+}
+
+/*-------------------------------------------------------------------------*/
+
+static void alarm_swap(uint8_t x, uint8_t y) {
+	uint8_t t = alarm_heap[x];
+	alarm_heap[x] = alarm_heap[y];
+	alarm_heap[y] = t;
+	alarm_pos[alarm_heap[x]] = x;
+	alarm_pos[alarm_heap[y]] = y;
+}
+
+static void alarm_up(uint8_t x) {
+	uint8_t parent;
+	while(x > 0) {
+		parent = (x - 1) >> 1;
+		if(alarm_table[alarm_heap[parent]].key <= alarm_table[alarm_heap[x]].key) {
+			break;
+		}
+		alarm_swap(x, parent);
+		x = parent;
+	}
+}
+
+static void alarm_down(uint8_t x) {
+	uint8_t child;
+	for(;;) {
+		child = (x << 1) + 1;
+		if(child >= alarm_count) {
+			break;
+		}
+		if(child + 1 < alarm_count && alarm_table[alarm_heap[child + 1]].key < alarm_table[alarm_heap[child]].key) {
+			child++;
+		}
+		if(alarm_table[alarm_heap[x]].key <= alarm_table[alarm_heap[child]].key) {
+			break;
+		}
+		alarm_swap(x, child);
+		x = child;
+	}
+}
+
+static void alarm_remove(uint8_t i) {
+	uint8_t x = alarm_pos[i];
+	if(x == 0xFF) {
+		return;
+	}
+	alarm_count--;
+	if(x != alarm_count) {
+		uint8_t moved = alarm_heap[alarm_count]; // the last entry fills the hole
+		alarm_swap(x, alarm_count);
+		alarm_up(x);
+		alarm_down(alarm_pos[moved]);
+	}
+	alarm_pos[i] = 0xFF;
+}
+
+/* Puts i at the right place for its key, adding it if it is not in the heap. */
+static void alarm_place(uint8_t i) {
+	uint8_t x = alarm_pos[i];
+	if(x == 0xFF) {
+		x = alarm_count++;
+		alarm_heap[x] = i;
+		alarm_pos[i] = x;
+	}
+	alarm_up(x);
+	alarm_down(alarm_pos[i]);
+}
+
+/* Works out i's next fire time from its rule and files it. */
+static void alarm_schedule(uint8_t i) {
+	xAlarm *a = &alarm_table[i];
+	uint16_t delta;
+
+	if(!(a->flags & ALARM_ENABLED)) {
+		alarm_remove(i);
+		return;
+	}
+	delta = alarm_delta(a, a->flags & ALARM_SKIP);
+	if(delta == 0) {
+		alarm_remove(i);
+		return;
+	}
+	a->key = alarm_clock + delta;
+	alarm_place(i);
+}
+
+/* Only the top of the heap goes to the DS3231. A top that is already due,
+set for the same minute as one that just rang or passed while another was
+ringing, would only match next week, so it is counted as a match now. */
+static void alarm_program(void) {
+	const xAlarm *a;
+	alarm_sync();
+	a = alarm_count ? &alarm_table[alarm_heap[0]] : 0;
+	if(a == 0) {
+		timesvc_clear_a1();
+		return;
+	}
+	timesvc_set_a1(a->fire_day, a->fire_hour, a->fire_min);
+	if(a->key <= alarm_clock) {
+		timesvc_fire_a1();
+	}
+}
+
+/*-------------------------------------------------------------------------*/
+
+void alarm_init(void) {
+	uint8_t i;
+	vTaskSuspendAll();
+	for(i = 0; i < ALARM_MAX; i++) {
+		alarm_table[i].flags = 0;
+		alarm_pos[i] = 0xFF;
+	}
+	alarm_count = 0;
+	alarm_sync();
+	alarm_clock = ALARM_CLOCK_BASE;
+	alarm_program();
+	(void) xTaskResumeAll();
+}
+
+void alarm_set(uint8_t i, uint8_t hour, uint8_t min, uint8_t days, uint8_t flags) {
+	xAlarm *a;
+	if(i >= ALARM_MAX || hour > 23 || min > 59) {
+		return;
+	}
+	vTaskSuspendAll();
+	a = &alarm_table[i];
+	a->hour = hour;
+	a->min = min;
+	a->days = days & 0x7F;
+	a->flags = flags & ~(ALARM_SNOOZED | ALARM_RINGING); // a new rule, a dismiss for the old one must not touch it
+	alarm_sync();
+	alarm_schedule(i);
+	alarm_program();
+	(void) xTaskResumeAll();
+}
+
+void alarm_clear(uint8_t i) {
+	if(i >= ALARM_MAX) {
+		return;
+	}
+	vTaskSuspendAll();
+	alarm_table[i].flags = 0;
+	alarm_remove(i);
+	alarm_program();
+	(void) xTaskResumeAll();
+}
+
+void alarm_skip_next(uint8_t i) {
+	if(i >= ALARM_MAX) {
+		return;
+	}
+	vTaskSuspendAll();
+	if(alarm_table[i].flags & ALARM_ENABLED) {
+		alarm_table[i].flags |= ALARM_SKIP;
+		alarm_table[i].flags &= ~ALARM_SNOOZED;
+		alarm_sync();
+		alarm_schedule(i);
+		alarm_program();
+	}
+	(void) xTaskResumeAll();
+}
+
+const xAlarm *alarm_get(uint8_t i) {
+	return (i < ALARM_MAX) ? &alarm_table[i] : 0;
+}
+
+const xAlarm *alarm_next(void) {
+	return alarm_count ? &alarm_table[alarm_heap[0]] : 0;
+}
+
+/* The alarm that rang is moved on at once, not when it is dismissed, so the
+next one is in the DS3231 while this one is still ringing. */
+uint8_t alarm_ring(void) {
+	uint8_t i = ALARM_NONE;
+	xAlarm *a;
+	vTaskSuspendAll();
+	alarm_sync();
+	if(alarm_count && alarm_table[alarm_heap[0]].key <= alarm_clock) {
+		i = alarm_heap[0];
+		a = &alarm_table[i];
+		a->flags |= ALARM_RINGING;
+		a->flags &= ~(ALARM_SNOOZED | ALARM_SKIP); // a skip was used up when it was scheduled
+		if(a->flags & ALARM_ONESHOT) {
+			alarm_remove(i); // back in the heap only if it is snoozed
+		}
+		else {
+			alarm_schedule(i); // its next day
+		}
+		alarm_program();
+	}
+	(void) xTaskResumeAll();
+	return i;
+}
+
+void alarm_dismiss(uint8_t i) {
+	xAlarm *a;
+	if(i >= ALARM_MAX) {
+		return;
+	}
+	vTaskSuspendAll();
+	a = &alarm_table[i];
+	if(a->flags & ALARM_RINGING) {
+		a->flags &= ~ALARM_RINGING;
+		if(a->flags & ALARM_ONESHOT) {
+			a->flags = 0;
+		}
+	}
+	(void) xTaskResumeAll();
+}
+
+void alarm_snooze(uint8_t i) {
+	uint16_t t;
+	xAlarm *a;
+	if(i >= ALARM_MAX) {
+		return;
+	}
+	vTaskSuspendAll();
+	a = &alarm_table[i];
+	if(a->flags & ALARM_RINGING) {
+		a->flags &= ~ALARM_RINGING;
+		alarm_sync();
+		t = alarm_mod + ALARM_SNOOZE_MIN;
+		a->fire_day = alarm_day;
+		if(t >= 1440) {
+			t -= 1440;
+			a->fire_day = (alarm_day == 7) ? 1 : alarm_day + 1;
+		}
+		a->fire_hour = t / 60;
+		a->fire_min = t % 60;
+		a->flags |= ALARM_SNOOZED;
+		a->key = alarm_clock + ALARM_SNOOZE_MIN;
+		alarm_place(i);
+		alarm_program();
+	}
+	(void) xTaskResumeAll();
+}
@@ -0,0 +1,52 @@
+/* Alarm table. The earliest alarm is kept at the top of a min-heap and is
+the only one programmed into DS3231 alarm 1, so nothing has to scan the
+table to find out when the next alarm is.
+Any task may call these. Each call that changes the table runs with the
+scheduler suspended, so a tick can not switch to another task in the
+middle of a heap update. The pointers from alarm_get and alarm_next are
+into the table itself and can change under the reader.
+FreeRTOS.h and task.h must be included before this file. */
+#ifndef ALARMS_H
+#define ALARMS_H
+
+#include <stdint.h>
+
+#define ALARM_MAX 8
+#define ALARM_SNOOZE_MIN 9
+
+#define ALARM_ENABLED 0x01
+#define ALARM_ONESHOT 0x02 // cleared from the table once dismissed
+#define ALARM_SKIP 0x04 // the next occurrence is skipped
+#define ALARM_SNOOZED 0x08 // fire time is a snooze, not the rule
+#define ALARM_RINGING 0x10 // alarm_ring handed it out, waiting for alarm_dismiss or alarm_snooze
+
+#define ALARM_NONE 0xFF
+
+#define ALARM_ANYDAY 0x00
+#define ALARM_WEEKDAYS 0x3E
+#define ALARM_WEEKENDS 0x41
+
+typedef struct {
+	uint8_t hour; // 0-23
+	uint8_t min;
+	uint8_t days; // bit 0 Sunday to bit 6 Saturday (ds3231 day 1-7), ALARM_ANYDAY for every day
+	uint8_t flags;
+	uint32_t key; // when it next fires, in minutes since alarm_init
+	uint8_t fire_day; // the same as day 1-7, hour and minute, for the DS3231
+	uint8_t fire_hour;
+	uint8_t fire_min;
+} xAlarm;
+
+void alarm_init(void); // after timesvc_start
+
+void alarm_set(uint8_t i, uint8_t hour, uint8_t min, uint8_t days, uint8_t flags); // slot i, O(log n)
+void alarm_clear(uint8_t i);
+void alarm_skip_next(uint8_t i);
+
+const xAlarm *alarm_get(uint8_t i); // slot i, flags 0 if it is empty
+const xAlarm *alarm_next(void); // the earliest alarm or 0, O(1)
+uint8_t alarm_ring(void); // alarm 1 matched: returns the slot that is due and moves it on, ALARM_NONE if none is
+void alarm_dismiss(uint8_t i); // slot i from alarm_ring is done: a one-shot goes, nothing if i was set again meanwhile
+void alarm_snooze(uint8_t i); // slot i from alarm_ring rings again in ALARM_SNOOZE_MIN
+
+#endif
@@ -0,0 +1,86 @@
+#include <avr/pgmspace.h>
+#include "lcd.h"
+#include "bigdigit.h"
+
+/* CGRAM glyphs, 5x8. Rounded corners and half height bars, combined below
+into 3x2 digits. */
+const unsigned char big_glyphs[8][8] PROGMEM = {
+	{0x07,0x0F,0x1F,0x1F,0x1F,0x1F,0x1F,0x1F}, // 0 upper left corner
+	{0x1F,0x1F,0x1F,0x00,0x00,0x00,0x00,0x00}, // 1 upper bar
+	{0x1C,0x1E,0x1F,0x1F,0x1F,0x1F,0x1F,0x1F}, // 2 upper right corner
+	{0x1F,0x1F,0x1F,0x1F,0x1F,0x1F,0x0F,0x07}, // 3 lower left corner
+	{0x00,0x00,0x00,0x00,0x00,0x1F,0x1F,0x1F}, // 4 lower bar
+	{0x1F,0x1F,0x1F,0x1F,0x1F,0x1F,0x1E,0x1C}, // 5 lower right corner
+	{0x1F,0x1F,0x1F,0x00,0x00,0x00,0x1F,0x1F}, // 6 upper and lower bar
+	{0x00,0x00,0x0E,0x0E,0x0E,0x00,0x00,0x00}  // 7 colon dot
+};
+
+#define BLK 0xFF // solid block in the character ROM
+#define SPC ' '
+
+/* top row then bottom row, CGRAM slots from above */
+const unsigned char big_digits[10][6] PROGMEM = {
+	{0,   1,   2,   3,   4,   5  }, // 0
+	{1,   2,   SPC, 4,   BLK, 4  }, // 1
+	{6,   6,   2,   3,   4,   4  }, // 2
+	{6,   6,   2,   4,   4,   5  }, // 3
+	{3,   4,   BLK, SPC, SPC, BLK}, // 4
+	{3,   6,   6,   4,   4,   5  }, // 5
+	{0,   6,   6,   3,   4,   5  }, // 6
+	{1,   1,   2,   SPC, SPC, BLK}, // 7
+	{0,   6,   2,   3,   4,   5  }, // 8
+	{0,   6,   2,   SPC, SPC, BLK}  // 9
+};
+
+const unsigned char big_columns[4] = {1, 4, 8, 11}; // H H : M M
+#define BIG_COLON 7
+
+/* digit on screen at each position, 0xFF if not known */
+static uint8_t big_shown[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+static uint8_t big_colon;
+
+void big_invalidate(void) {
+	unsigned char i;
+	for(i = 0; i < 4; i++) {
+		big_shown[i] = 0xFF;
+	}
+	big_colon = 0;
+}
+
+static void big_digit(unsigned char pos, uint8_t d) {
+	const unsigned char* cell = big_digits[d];
+	unsigned char column = big_columns[pos];
+
+	if(big_shown[pos] == d) {
+		return;
+	}
+	LCD_Cursor(column);
+	LCD_WriteData(pgm_read_byte(cell));
+	LCD_WriteData(pgm_read_byte(cell + 1));
+	LCD_WriteData(pgm_read_byte(cell + 2));
+	LCD_Cursor(column + 16);
+	LCD_WriteData(pgm_read_byte(cell + 3));
+	LCD_WriteData(pgm_read_byte(cell + 4));
+	LCD_WriteData(pgm_read_byte(cell + 5));
+	big_shown[pos] = d;
+}
+
+void big_time(uint8_t hrbcd, uint8_t minbcd) {
+	unsigned char i;
+
+	// no-op unless another screen replaced the glyphs
+	for(i = 0; i < 8; i++) {
+		LCD_LoadGlyph_P(i, big_glyphs[i]);
+	}
+
+	big_digit(0, hrbcd >> 4);
+	big_digit(1, hrbcd & 0x0F);
+	big_digit(2, minbcd >> 4);
+	big_digit(3, minbcd & 0x0F);
+
+	if(!big_colon) {
+		SLCD_WriteData(BIG_COLON, 7);
+		SLCD_WriteData(BIG_COLON + 16, 7);
+		big_colon = 1;
+	}
+}
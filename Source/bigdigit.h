@@ -0,0 +1,13 @@
+/* Two row tall digits for the clock face, drawn with the CGRAM glyphs */
+#ifndef BIGDIGIT_H
+#define BIGDIGIT_H
+
+#include <stdint.h>
+
+// Every digit is 3 columns wide. HH:MM takes columns 1-13 of both lines:
+// hours at 1 and 4, the colon at 7, minutes at 8 and 11.
+
+void big_invalidate(void); // the screen was cleared or drawn over, redraw everything next time
+void big_time(uint8_t hrbcd, uint8_t minbcd); // redraws only the digits that changed
+
+#endif
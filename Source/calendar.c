@@ -0,0 +1,152 @@
+#include <avr/pgmspace.h>
+#include "calendar.h"
+
+/* AVR has no divide instruction and a 32 bit divide is a long libgcc loop,
+so the tables below are built by the compiler and the conversions use
+multiplies, compares and 8 or 16 bit divides only. */
+
+#define CAL_DAY_SECS 86400UL
+
+// days before January 1st of year y
+#define CAL_Y(y) ((y) * 365U + ((y) + 3) / 4)
+#define CAL_Y10(t) CAL_Y(t), CAL_Y(t + 1), CAL_Y(t + 2), CAL_Y(t + 3), CAL_Y(t + 4), \
+	CAL_Y(t + 5), CAL_Y(t + 6), CAL_Y(t + 7), CAL_Y(t + 8), CAL_Y(t + 9)
+
+static const uint16_t cal_year_days[101] PROGMEM = {
+	CAL_Y10(0), CAL_Y10(10), CAL_Y10(20), CAL_Y10(30), CAL_Y10(40),
+	CAL_Y10(50), CAL_Y10(60), CAL_Y10(70), CAL_Y10(80), CAL_Y10(90), CAL_Y(100)
+};
+
+// month lengths, l is 1 in a leap year
+#define CAL_JAN 31
+#define CAL_FEB(l) (28 + (l))
+#define CAL_MAR 31
+#define CAL_APR 30
+#define CAL_MAY 31
+#define CAL_JUN 30
+#define CAL_JUL 31
+#define CAL_AUG 31
+#define CAL_SEP 30
+#define CAL_OCT 31
+#define CAL_NOV 30
+#define CAL_DEC 31
+
+#define CAL_LEN(l) {0, CAL_JAN, CAL_FEB(l), CAL_MAR, CAL_APR, CAL_MAY, CAL_JUN, \
+	CAL_JUL, CAL_AUG, CAL_SEP, CAL_OCT, CAL_NOV, CAL_DEC}
+
+// days before the first of each month, the 13th entry is the length of the year
+#define CAL_CUM(l) {0, \
+	CAL_JAN, \
+	CAL_JAN + CAL_FEB(l), \
+	CAL_JAN + CAL_FEB(l) + CAL_MAR, \
+	CAL_JAN + CAL_FEB(l) + CAL_MAR + CAL_APR, \
+	CAL_JAN + CAL_FEB(l) + CAL_MAR + CAL_APR + CAL_MAY, \
+	CAL_JAN + CAL_FEB(l) + CAL_MAR + CAL_APR + CAL_MAY + CAL_JUN, \
+	CAL_JAN + CAL_FEB(l) + CAL_MAR + CAL_APR + CAL_MAY + CAL_JUN + CAL_JUL, \
+	CAL_JAN + CAL_FEB(l) + CAL_MAR + CAL_APR + CAL_MAY + CAL_JUN + CAL_JUL + CAL_AUG, \
+	CAL_JAN + CAL_FEB(l) + CAL_MAR + CAL_APR + CAL_MAY + CAL_JUN + CAL_JUL + CAL_AUG + CAL_SEP, \
+	CAL_JAN + CAL_FEB(l) + CAL_MAR + CAL_APR + CAL_MAY + CAL_JUN + CAL_JUL + CAL_AUG + CAL_SEP + CAL_OCT, \
+	CAL_JAN + CAL_FEB(l) + CAL_MAR + CAL_APR + CAL_MAY + CAL_JUN + CAL_JUL + CAL_AUG + CAL_SEP + CAL_OCT + CAL_NOV, \
+	CAL_JAN + CAL_FEB(l) + CAL_MAR + CAL_APR + CAL_MAY + CAL_JUN + CAL_JUL + CAL_AUG + CAL_SEP + CAL_OCT + CAL_NOV + CAL_DEC}
+
+static const uint8_t cal_month_lens[2][13] PROGMEM = {CAL_LEN(0), CAL_LEN(1)};
+static const uint16_t cal_month_days[2][13] PROGMEM = {CAL_CUM(0), CAL_CUM(1)};
+
+/* Sakamoto's offsets for the day of the week, one per month. With the year
+only running 0-99 the whole sum fits in a byte. */
+static const uint8_t cal_dow_offset[12] PROGMEM = {0, 3, 2, 5, 0, 3, 5, 1, 4, 6, 2, 4};
+
+uint8_t cal_is_leap(uint8_t year) {
+	return (year & 3) == 0;
+}
+
+uint8_t cal_month_len(uint8_t year, uint8_t month) {
+	return pgm_read_byte(&cal_month_lens[cal_is_leap(year)][month]);
+}
+
+uint16_t cal_days(uint8_t year, uint8_t month, uint8_t date) {
+	return pgm_read_word(&cal_year_days[year]) + pgm_read_word(&cal_month_days[cal_is_leap(year)][month - 1]) + date - 1;
+}
+
+uint8_t cal_dow(uint8_t year, uint8_t month, uint8_t date) {
+	/* For years 2000-2099 the century terms of Sakamoto's formula add up to
+	a multiple of 7 and drop out. */
+	uint8_t s = pgm_read_byte(&cal_dow_offset[month - 1]) + date;
+	if(month < 3) {
+		if(year == 0) {
+			return (s + 5) % 7 + 1; // January and February count as 1999, whose terms leave 5
+		}
+		year--;
+	}
+	return (uint8_t)(year + (year >> 2) + s) % 7 + 1;
+}
+
+uint32_t cal_to_epoch(const xCalTime *t) {
+	return (uint32_t)cal_days(t->year, t->month, t->date) * CAL_DAY_SECS
+		+ (uint16_t)t->hour * 3600U + (uint16_t)t->min * 60U + t->sec;
+}
+
+/* The day and the year are estimated with a multiply by a scaled reciprocal
+and then corrected against the tables, at most one step each. The day takes
+two multiplies, the reciprocal is not exact enough for one. Only the time
+of day needs divides, and those are 16 bit. */
+void cal_from_epoch(uint32_t epoch, xCalTime *t) {
+	uint16_t d, d2, doy, sod;
+	uint32_t ds, rem;
+	uint8_t y, m, leap;
+
+	d = (uint16_t)(((epoch >> 7) * 97) >> 16); // 86400 is 128 * 675, 97 / 65536 is just under 1 / 675
+	ds = (uint32_t)d * CAL_DAY_SECS;
+	while(ds > epoch) {
+		d--;
+		ds -= CAL_DAY_SECS;
+	}
+	rem = epoch - ds;
+	d2 = (uint16_t)(((rem >> 7) * 97) >> 16); // the first estimate is up to 34 days short by 2099, a second pass on what is left
+	d += d2;
+	rem -= (uint32_t)d2 * CAL_DAY_SECS;
+	while(rem >= CAL_DAY_SECS) { // once at most
+		d++;
+		rem -= CAL_DAY_SECS;
+	}
+
+	t->hour = (uint16_t)(rem >> 4) / 225; // 3600 is 16 * 225
+	sod = (uint16_t)(rem - (uint16_t)t->hour * 3600U);
+	t->min = sod / 60;
+	t->sec = sod - (uint16_t)t->min * 60;
+
+	y = (uint8_t)(((uint32_t)d * 179) >> 16); // 179 / 65536 is just under 1 / 365.25
+	while(y < 99 && pgm_read_word(&cal_year_days[y + 1]) <= d) {
+		y++;
+	}
+	while(pgm_read_word(&cal_year_days[y]) > d) {
+		y--;
+	}
+	doy = d - pgm_read_word(&cal_year_days[y]);
+	leap = cal_is_leap(y);
+
+	m = doy >> 5; // no month is longer than 32 days, so this is never past the right one
+	while(m < 11 && pgm_read_word(&cal_month_days[leap][m + 1]) <= doy) {
+		m++;
+	}
+
+	t->year = y;
+	t->month = m + 1;
+	t->date = doy - pgm_read_word(&cal_month_days[leap][m]) + 1;
+	t->day = cal_dow(t->year, t->month, t->date);
+}
+
+uint8_t cal_hour12(uint8_t hour, uint8_t *pm) {
+	*pm = (hour >= 12) ? 1 : 0;
+	if(hour == 0) {
+		return 12;
+	}
+	return (hour > 12) ? hour - 12 : hour;
+}
+
+uint8_t cal_hour24(uint8_t hour, uint8_t pm) {
+	if(hour == 12) {
+		hour = 0;
+	}
+	return pm ? hour + 12 : hour;
+}
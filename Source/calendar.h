@@ -0,0 +1,31 @@
+/* Calendar arithmetic for 2000-01-01 to 2099-12-31. Every fourth year is a
+leap year in that range, 2000 included, so no century rules are needed. */
+#ifndef CALENDAR_H
+#define CALENDAR_H
+
+#include <stdint.h>
+
+#define CAL_SUNDAY 1 // day of the week numbering follows the DS3231, 1-7
+
+typedef struct {
+	uint8_t year; // 0-99
+	uint8_t month; // 1-12
+	uint8_t date; // 1-31
+	uint8_t hour; // 0-23
+	uint8_t min;
+	uint8_t sec;
+	uint8_t day; // 1-7, filled in by cal_from_epoch, ignored by cal_to_epoch
+} xCalTime;
+
+uint8_t cal_is_leap(uint8_t year);
+uint8_t cal_month_len(uint8_t year, uint8_t month);
+uint16_t cal_days(uint8_t year, uint8_t month, uint8_t date); // days since 2000-01-01
+uint8_t cal_dow(uint8_t year, uint8_t month, uint8_t date); // 1-7, Sunday is 1
+
+uint32_t cal_to_epoch(const xCalTime *t); // seconds since 2000-01-01 00:00:00
+void cal_from_epoch(uint32_t epoch, xCalTime *t);
+
+uint8_t cal_hour12(uint8_t hour, uint8_t *pm); // 0-23 to 1-12, *pm set to 0 or 1
+uint8_t cal_hour24(uint8_t hour, uint8_t pm); // 1-12 and AM/PM to 0-23
+
+#endif
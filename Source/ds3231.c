@@ -1,148 +1,408 @@
-#include "ds3231.h"
-#include "i2c_master.h"
-#include <util/delay.h>
-
-#define DS3231_READ 0xD1
-#define DS3231_WRITE 0xD0
-
-/* DS3231 conversions */
-uint8_t dec2bcd(uint8_t d)
-{
-	return ((d/10 * 16) + (d % 10));
-}
-
-uint8_t bcd2dec(uint8_t b)
-{
-	return ((b/16 * 10) + (b % 16));
-}
-
-void ds3231_init(void) {
-	
-	i2c_init();
-
-}
-
-void ds3231_set(uint8_t hr,uint8_t min,uint8_t sec,uint8_t ampm,uint8_t yr,uint8_t mnth,uint8_t dt,uint8_t day) {
-	
-	/* The first byte transmitted by the master is the slave address. 
-	Next follows a number of date bytes. The slaves returns an ACK 
-	after each received byte. Data is transferred with MSB first.
-	DS3231 pg 16 */
-	
-	hr &= 0x1F; // clear first 3 bits which are ampm, 24 hour bits
-	hr |= 0x40; // standard is AMPM, D6 = 1, D5 = 0
-	hr |= (ampm<<5); // 1 = PM 0 = AM
-	
-	i2c_start(DS3231_WRITE); // write
-	i2c_write(0x00); // starting at address of seconds register
-	i2c_write(sec); // increments to next register after every byte
-	i2c_write(min);
-	i2c_write(hr);
-	i2c_write(day);
-	i2c_write(dt);
-	i2c_write(mnth);
-	i2c_write(yr);
-	i2c_stop();
-	
-}
-
-void ds3231_get(uint8_t *h,uint8_t *m,uint8_t *s,uint8_t *yr,uint8_t *mnth,uint8_t *dt,uint8_t *day) {
-	
-	/* The first byte transmitted by the master is the slave address.
-	The slave then returns an ACK. Next follows a number of data bytes
-	from slave to master. The master returns ACK after all received 
-	bytes other than the last one. The last is a NACK. The master 
-	generates the START and STOP. DS3231 pg 16*/
-	
-	i2c_start(DS3231_WRITE);
-	i2c_write(0x00);
-	
-	i2c_start(DS3231_READ); // read
-	
-	*s = i2c_read_ack(); // seconds
-	*m = i2c_read_ack(); // minutes
-	*h = i2c_read_ack(); // hour
-	*day = i2c_read_ack(); // day
-	*dt = i2c_read_ack(); // date
-	*mnth = i2c_read_ack(); // month 
-	*yr = i2c_read_nack(); // year
-	
-	i2c_stop();
-	
-}
-
-void ds3231_setHr(uint8_t hour_ref, uint8_t hr) {
-	
-	/* If hour_ref == 0x00, set clock to 12 hour
-	If hour_ref == 0x01 set clock to 24 hour  */
-	
-	uint8_t hr_hold = hr;
-	i2c_start(DS3231_WRITE); // write
-	i2c_write(0x02); // hour register
-	if(hr_hold & 0x40) { // currently 12 hour mode
-		if(hour_ref == 0x00) { // it is already in 12 hour mode
-			i2c_stop();
-			return;
-		}
-		else { // change to 24 hour mode
-			if(hr_hold & 0x20) { // if PM, add 12
-				hr_hold = bcd2dec(hr_hold & 0x1F);
-				if(hr_hold == 12) {
-					hr_hold = 0;
-				}
-				else {
-					hr_hold += 12;
-				}
-				hr_hold = dec2bcd(hr_hold);
-				i2c_write(hr_hold & 0x3F);
-				i2c_stop();
-				return;
-			}
-			else { // if AM, do nothing except for 12AM
-				hr_hold = bcd2dec(hr_hold & 0x1F); // AM
-				if(hr_hold == 12) { // if 12AM, sub 12
-					hr_hold = 0;
-				}
-				hr_hold = dec2bcd(hr_hold);
-				i2c_write(hr_hold & 0x3F);
-				i2c_stop();
-				return;
-			}
-		}
-	}
-	else { // currently 24 hour mode
-		if(hour_ref == 0x01) { // it is already 24 hour mode
-			i2c_stop();
-			return;
-		}
-		else { // change to 12 hour mode
-			hr_hold &= 0x3F; // clear non hour bits
-			hr_hold = bcd2dec(hr_hold);
-			if(hr_hold > 12) { // set pm bit and sub 12
-				hr_hold -= 12;
-				hr_hold = dec2bcd(hr_hold);
-				i2c_write(hr_hold | 0x60);
-				i2c_stop();
-				return;
-			}
-			else { // keep am 
-				hr_hold = dec2bcd(hr_hold);
-				i2c_write(hr_hold | 0x40);
-				i2c_stop();
-				return;
-			}
-		}
-	}
-}
-
-void ds3231_getT(uint8_t *temp) {
-	
-	/* read upper byte temperature reg 0x11 */
-	i2c_start(DS3231_WRITE);
-	i2c_write(0x11);
-		
-	i2c_start(DS3231_READ); // read
-	*temp = i2c_read_nack();
-	i2c_stop();
-		
-}
\ No newline at end of file
+#include "FreeRTOS.h"
+#include "task.h"
+#include "ds3231.h"
+#include "i2cbus.h"
+#include "numfmt.h"
+#include <string.h>
+#include <util/delay.h>
+
+#define DS3231_READ 0xD1
+#define DS3231_WRITE 0xD0
+
+/* DS3231 conversions */
+#define dec2bcd(d) num_dec2bcd(d)
+#define bcd2dec(b) num_bcd2dec(b)
+
+/* Register cache. Every register belongs to one group, and a group says
+how long a copy of it can be trusted:
+DS_NEVER: changes by itself at any time, always read (time, status)
+DS_TICKS: the chip only updates it every so often (temperature)
+DS_DAY: changes at midnight, dropped when the time wraps past midnight
+and after DS3231_DAY_RECHECK_MS anyway (day, date, month, year)
+DS_WRITE: only changes when we write it (alarms, control, aging)
+Writes go to the chip and the cache both. Only the task that owns the
+DS3231 may call these functions. */
+#define DS_NEVER 0
+#define DS_TICKS 1
+#define DS_DAY 2
+#define DS_WRITE 3
+
+typedef struct {
+	uint8_t first;
+	uint8_t count;
+	uint8_t policy;
+	portTickType life; // DS_TICKS and DS_DAY
+} xDsGroup;
+
+static const xDsGroup ds_groups[DS3231_GROUPS] = {
+	[DS3231_GROUP_TIME] = {0x00, 3, DS_NEVER, 0},
+	[DS3231_GROUP_DATE] = {0x03, 4, DS_DAY, DS3231_DAY_RECHECK_MS / portTICK_RATE_MS},
+	[DS3231_GROUP_ALARM1] = {0x07, 4, DS_WRITE, 0},
+	[DS3231_GROUP_ALARM2] = {0x0B, 3, DS_WRITE, 0},
+	[DS3231_GROUP_CONTROL] = {0x0E, 1, DS_WRITE, 0},
+	[DS3231_GROUP_STATUS] = {0x0F, 1, DS_NEVER, 0},
+	[DS3231_GROUP_AGING] = {0x10, 1, DS_WRITE, 0},
+	[DS3231_GROUP_TEMP] = {0x11, 2, DS_TICKS, DS3231_TEMP_MS / portTICK_RATE_MS}
+};
+
+static uint8_t ds_cache[DS3231_REGS];
+static uint8_t ds_valid[DS3231_GROUPS];
+static portTickType ds_stamp[DS3231_GROUPS];
+static uint16_t ds_last_mod = 0; // minute of the day at the last time read, for the midnight check
+
+/* Forced temperature conversion. Setting CONV starts one, the chip clears
+CONV and BSY when the result is in 0x11-0x12. Control and status are read
+with a queued transfer that nobody waits on, ds3231_conv_poll looks at it
+the next time round. */
+#define DS_CONV_IDLE 0
+#define DS_CONV_WAIT 1 // status read queued
+#define DS_CONV_TRIES 50 // status reads before giving up on a conversion, 5s at the time service's poll rate
+static uint8_t ds_conv = DS_CONV_IDLE;
+static uint8_t ds_conv_tries;
+static uint8_t ds_conv_regs[2]; // control, status
+static xI2CXfer ds_conv_x;
+
+uint16_t ds3231_hits[DS3231_GROUPS];
+uint16_t ds3231_misses[DS3231_GROUPS];
+
+static uint8_t ds_fresh(uint8_t g, portTickType now) {
+	const xDsGroup *grp = &ds_groups[g];
+	if(!ds_valid[g] || grp->policy == DS_NEVER) {
+		return 0;
+	}
+	if(grp->policy == DS_WRITE) {
+		return 1;
+	}
+	return (portTickType)(now - ds_stamp[g]) < grp->life;
+}
+
+/* Copies len registers from reg into buf. Groups that are not fresh are
+read from the chip, all in one transfer. */
+static void ds_read(uint8_t reg, uint8_t *buf, uint8_t len) {
+	portTickType now = xTaskGetTickCount();
+	uint8_t lo = 0xFF;
+	uint8_t hi = 0;
+	uint8_t g, first, end;
+
+	for(g = 0; g < DS3231_GROUPS; g++) {
+		first = ds_groups[g].first;
+		end = first + ds_groups[g].count;
+		if(end <= reg || first >= reg + len) {
+			continue;
+		}
+		if(ds_fresh(g, now)) {
+			ds3231_hits[g]++;
+		}
+		else {
+			ds3231_misses[g]++;
+			if(first < lo) {
+				lo = first;
+			}
+			if(end > hi) {
+				hi = end;
+			}
+		}
+	}
+
+	if(lo != 0xFF && i2cbus_read(DS3231_WRITE, lo, &ds_cache[lo], hi - lo, I2CBUS_PRIO_RTC) == I2C_XFER_OK) {
+		for(g = 0; g < DS3231_GROUPS; g++) {
+			if(ds_groups[g].first >= lo && ds_groups[g].first + ds_groups[g].count <= hi) {
+				ds_valid[g] = 1;
+				ds_stamp[g] = now;
+			}
+		}
+	}
+	memcpy(buf, &ds_cache[reg], len);
+}
+
+static void ds_write(uint8_t reg, const uint8_t *buf, uint8_t len) {
+	uint8_t g;
+	if(i2cbus_write(DS3231_WRITE, reg, buf, len, I2CBUS_PRIO_RTC) != I2C_XFER_OK) {
+		ds3231_cache_flush(); // not sure what the chip holds now
+		return;
+	}
+	memcpy(&ds_cache[reg], buf, len);
+	for(g = 0; g < DS3231_GROUPS; g++) {
+		if(ds_groups[g].first >= reg && ds_groups[g].first + ds_groups[g].count <= reg + len) {
+			ds_valid[g] = 1; // the whole group was written
+			ds_stamp[g] = xTaskGetTickCount();
+		}
+	}
+}
+
+/* Drops groups that have outlived their life, so an age that has run past
+the range of the tick counter can not look fresh again. */
+static void ds_expire(portTickType now) {
+	uint8_t g;
+	for(g = 0; g < DS3231_GROUPS; g++) {
+		if(ds_valid[g] && (ds_groups[g].policy == DS_TICKS || ds_groups[g].policy == DS_DAY) && !ds_fresh(g, now)) {
+			ds_valid[g] = 0;
+		}
+	}
+}
+
+/* Minute of the day from the hour and minute registers, either hour mode. */
+static uint16_t ds_mod(uint8_t hour, uint8_t min) {
+	uint8_t h;
+	if(hour & 0x40) { // 12 hour mode
+		h = bcd2dec(hour & 0x1F);
+		if(h == 12) {
+			h = 0;
+		}
+		if(hour & 0x20) {
+			h += 12;
+		}
+	}
+	else {
+		h = bcd2dec(hour & 0x3F);
+	}
+	return (uint16_t)h * 60 + bcd2dec(min);
+}
+
+void ds3231_cache_flush(void) {
+	uint8_t g;
+	for(g = 0; g < DS3231_GROUPS; g++) {
+		ds_valid[g] = 0;
+	}
+}
+
+void ds3231_init(void) {
+	
+	/* the TWI is set up by i2cbus_start, every transfer goes through
+	the bus task */
+
+}
+
+void ds3231_set(uint8_t hr,uint8_t min,uint8_t sec,uint8_t ampm,uint8_t yr,uint8_t mnth,uint8_t dt,uint8_t day) {
+	
+	/* The first byte transmitted by the master is the slave address. 
+	Next follows a number of date bytes. The slaves returns an ACK 
+	after each received byte. Data is transferred with MSB first.
+	DS3231 pg 16 */
+	
+	uint8_t regs[7];
+	hr &= 0x1F; // clear first 3 bits which are ampm, 24 hour bits
+	hr |= 0x40; // standard is AMPM, D6 = 1, D5 = 0
+	hr |= (ampm<<5); // 1 = PM 0 = AM
+	
+	regs[0] = sec; // starting at address of seconds register
+	regs[1] = min; // increments to next register after every byte
+	regs[2] = hr;
+	regs[3] = day;
+	regs[4] = dt;
+	regs[5] = mnth;
+	regs[6] = yr;
+	ds_write(0x00, regs, 7);
+	
+}
+
+void ds3231_get(uint8_t *h,uint8_t *m,uint8_t *s,uint8_t *yr,uint8_t *mnth,uint8_t *dt,uint8_t *day) {
+	
+	/* The first byte transmitted by the master is the slave address.
+	The slave then returns an ACK. Next follows a number of data bytes
+	from slave to master. The master returns ACK after all received 
+	bytes other than the last one. The last is a NACK. The master 
+	generates the START and STOP. DS3231 pg 16*/
+	
+	uint8_t regs[7];
+	portTickType now = xTaskGetTickCount();
+	
+	/* The chip copies all of 0x00-0x06 at the start of a read, so one
+	transfer can not tear across midnight. Two can, so the time is only read
+	on its own while the cached date is good and the time has not wrapped. */
+	ds_expire(now);
+	if(ds_fresh(DS3231_GROUP_DATE, now)) {
+		ds_read(0x00, regs, 3);
+		if(ds_mod(regs[2], regs[1]) >= ds_last_mod) {
+			ds_read(0x03, &regs[3], 4); // from the cache
+		}
+		else {
+			ds_valid[DS3231_GROUP_DATE] = 0; // past midnight, the date has moved on
+		}
+	}
+	if(!ds_valid[DS3231_GROUP_DATE]) {
+		ds_read(0x00, regs, 7); // time and date in one transfer
+	}
+	ds_last_mod = ds_mod(regs[2], regs[1]);
+	
+	*s = regs[0]; // seconds
+	*m = regs[1]; // minutes
+	*h = regs[2]; // hour
+	*day = regs[3]; // day
+	*dt = regs[4]; // date
+	*mnth = regs[5]; // month 
+	*yr = regs[6]; // year
+	
+}
+
+void ds3231_setHr(uint8_t hour_ref, uint8_t hr) {
+	
+	/* If hour_ref == 0x00, set clock to 12 hour
+	If hour_ref == 0x01 set clock to 24 hour  */
+	
+	uint8_t hr_hold = hr;
+	if(hr_hold & 0x40) { // currently 12 hour mode
+		if(hour_ref == 0x00) { // it is already in 12 hour mode
+			return;
+		}
+		hr_hold = bcd2dec(hr_hold & 0x1F);
+		if(hr & 0x20) { // if PM, add 12 except for 12PM
+			if(hr_hold != 12) {
+				hr_hold += 12;
+			}
+		}
+		else if(hr_hold == 12) { // if AM, do nothing except for 12AM
+			hr_hold = 0;
+		}
+		ds3231_writeReg(0x02, dec2bcd(hr_hold) & 0x3F);
+	}
+	else { // currently 24 hour mode
+		if(hour_ref == 0x01) { // it is already 24 hour mode
+			return;
+		}
+		hr_hold = bcd2dec(hr_hold & 0x3F); // clear non hour bits
+		if(hr_hold > 12) { // set pm bit and sub 12
+			ds3231_writeReg(0x02, dec2bcd(hr_hold - 12) | 0x60);
+		}
+		else if(hr_hold == 12) { // 12PM
+			ds3231_writeReg(0x02, 0x12 | 0x60);
+		}
+		else if(hr_hold == 0) { // 12AM
+			ds3231_writeReg(0x02, 0x12 | 0x40);
+		}
+		else { // keep am 
+			ds3231_writeReg(0x02, dec2bcd(hr_hold) | 0x40);
+		}
+	}
+}
+
+void ds3231_getT(uint8_t *temp) {
+	
+	/* read upper byte temperature reg 0x11 */
+	ds_read(0x11, temp, 1);
+		
+}
+
+uint8_t ds3231_readReg(uint8_t reg) {
+	
+	uint8_t val = 0;
+	if(reg < DS3231_REGS) {
+		ds_read(reg, &val, 1);
+	}
+	return val;
+	
+}
+
+void ds3231_writeReg(uint8_t reg, uint8_t val) {
+	
+	if(reg < DS3231_REGS) {
+		ds_write(reg, &val, 1);
+	}
+	
+}
+
+void ds3231_setA1(uint8_t day, uint8_t hr, uint8_t min) {
+	
+	/* Alarm 1 matches day of week, hours, minutes and seconds 00:
+	A1M1-A1M4 all 0, DY/DT = 1. hr is in the same format as the hour
+	register, so it has to follow the 12/24 hour mode. DS3231 pg 12 */
+	
+	uint8_t regs[4];
+	regs[0] = 0x00; // alarm 1 seconds
+	regs[1] = min;
+	regs[2] = hr;
+	regs[3] = 0x40 | day;
+	ds_write(0x07, regs, 4);
+	
+	ds3231_writeReg(0x0F, ds3231_readReg(0x0F) & ~0x01); // clear A1F
+	ds3231_writeReg(0x0E, ds3231_readReg(0x0E) | 0x05); // INTCN, A1IE
+	
+}
+
+void ds3231_clearA1(void) {
+	
+	ds3231_writeReg(0x0E, ds3231_readReg(0x0E) & ~0x01); // A1IE off
+	ds3231_writeReg(0x0F, ds3231_readReg(0x0F) & ~0x01); // clear A1F
+	
+}
+
+uint8_t ds3231_checkA1(void) {
+	
+	/* A1F is set on a match whether A1IE is on or not, it stays set
+	until cleared */
+	uint8_t status = ds3231_readReg(0x0F);
+	if(status & 0x01) {
+		ds3231_writeReg(0x0F, status & ~0x01);
+		return 1;
+	}
+	return 0;
+	
+}
+
+static void ds_conv_check(void) {
+	ds_conv_x.addr = DS3231_WRITE;
+	ds_conv_x.reg = 0x0E;
+	ds_conv_x.flags = I2C_XFER_READ;
+	ds_conv_x.len = 2;
+	ds_conv_x.data = ds_conv_regs;
+	ds_conv_x.prio = I2CBUS_PRIO_RTC;
+	ds_conv_x.task = NULL;
+	ds_conv_x.done = NULL;
+	i2cbus_submit(&ds_conv_x);
+}
+
+uint8_t ds3231_conv_start(void) {
+	
+	/* CONV must not be set while BSY is, the chip is then doing its own
+	conversion and that result is as good. DS3231 pg 14 */
+	if(ds_conv != DS_CONV_IDLE) {
+		return 0;
+	}
+	if(!(ds3231_readReg(0x0F) & 0x04)) {
+		ds3231_writeReg(0x0E, ds3231_readReg(0x0E) | 0x20);
+		ds_cache[0x0E] &= ~0x20; // CONV clears itself, the cache must not write it back
+	}
+	ds_conv = DS_CONV_WAIT;
+	ds_conv_tries = DS_CONV_TRIES;
+	ds_conv_check();
+	return 1;
+	
+}
+
+uint8_t ds3231_conv_poll(void) {
+	
+	uint8_t temp[2];
+	if(ds_conv == DS_CONV_IDLE || ds_conv_x.status == I2C_XFER_QUEUED) {
+		return 0;
+	}
+	if(ds_conv_x.status == I2C_XFER_ERROR || (ds_conv_regs[0] & 0x20) || (ds_conv_regs[1] & 0x04)) {
+		if(--ds_conv_tries == 0) { // chip not answering or stuck, the next ds3231_conv_start tries again
+			ds_conv = DS_CONV_IDLE;
+			return 0;
+		}
+		ds_conv_check(); // still converting, look again next time
+		return 0;
+	}
+	ds_conv = DS_CONV_IDLE;
+	ds_valid[DS3231_GROUP_TEMP] = 0;
+	ds_read(0x11, temp, 2); // stamps the temperature group with now
+	return 1;
+	
+}
+
+uint8_t ds3231_conv_busy(void) {
+	return ds_conv != DS_CONV_IDLE;
+}
+
+int8_t ds3231_temp(portTickType *age) {
+	
+	portTickType now = xTaskGetTickCount();
+	if(ds_fresh(DS3231_GROUP_TEMP, now)) {
+		*age = now - ds_stamp[DS3231_GROUP_TEMP];
+	}
+	else {
+		*age = DS3231_TEMP_OLD;
+	}
+	return (int8_t)ds_cache[0x11];
+	
+}
@@ -1,13 +1,49 @@
-/* DS3231 library functions */
-#ifndef DS3231_H
-#define DS3231_H
-
-#include <avr/io.h>
-
-void ds3231_init(void);
-void ds3231_set(uint8_t hr,uint8_t min,uint8_t sec,uint8_t ampm,uint8_t yr,uint8_t mnth,uint8_t dt,uint8_t day);
-void ds3231_get(uint8_t *h,uint8_t *m,uint8_t *s,uint8_t *yr,uint8_t *mnth,uint8_t *dt,uint8_t *day);
-void ds3231_setHr(uint8_t hour_ref, uint8_t hr);
-void ds3231_getT(uint8_t *temp);
-
+/* DS3231 library functions */
+#ifndef DS3231_H
+#define DS3231_H
+
+#include <avr/io.h>
+
+/* Register cache, see ds3231.c. FreeRTOS.h must be included before this
+file. */
+#define DS3231_REGS 0x13
+#define DS3231_TEMP_MS 64000UL // the chip converts every 64 seconds
+#define DS3231_DAY_RECHECK_MS 60000UL // the date is read again after this even without a midnight
+
+#define DS3231_GROUP_TIME 0 // seconds, minutes, hours
+#define DS3231_GROUP_DATE 1 // day, date, month, year
+#define DS3231_GROUP_ALARM1 2
+#define DS3231_GROUP_ALARM2 3
+#define DS3231_GROUP_CONTROL 4
+#define DS3231_GROUP_STATUS 5
+#define DS3231_GROUP_AGING 6
+#define DS3231_GROUP_TEMP 7
+#define DS3231_GROUPS 8
+
+extern uint16_t ds3231_hits[DS3231_GROUPS]; // reads served from the cache
+extern uint16_t ds3231_misses[DS3231_GROUPS]; // reads that went to the chip
+
+void ds3231_cache_flush(void);
+
+/* Temperature conversions on demand. None of these wait for the chip, the
+owner of the DS3231 calls ds3231_conv_poll until it says the new value is
+in. */
+#define DS3231_TEMP_OLD portMAX_DELAY // age of a temperature older than DS3231_TEMP_MS, or never read
+
+uint8_t ds3231_conv_start(void); // 1 if a conversion was started, 0 if one is already running
+uint8_t ds3231_conv_poll(void); // 1 once, when the conversion has finished and the result is cached; 0 if it gave up after about 5s
+uint8_t ds3231_conv_busy(void);
+int8_t ds3231_temp(portTickType *age); // cached whole degrees C and ticks since they were measured, no I2C
+
+void ds3231_init(void);
+void ds3231_set(uint8_t hr,uint8_t min,uint8_t sec,uint8_t ampm,uint8_t yr,uint8_t mnth,uint8_t dt,uint8_t day);
+void ds3231_get(uint8_t *h,uint8_t *m,uint8_t *s,uint8_t *yr,uint8_t *mnth,uint8_t *dt,uint8_t *day);
+void ds3231_setHr(uint8_t hour_ref, uint8_t hr);
+void ds3231_getT(uint8_t *temp);
+uint8_t ds3231_readReg(uint8_t reg);
+void ds3231_writeReg(uint8_t reg, uint8_t val);
+void ds3231_setA1(uint8_t day, uint8_t hr, uint8_t min);
+void ds3231_clearA1(void);
+uint8_t ds3231_checkA1(void);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,281 @@
+/*
+ * Event groups - see event_groups.h.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_EVENT_GROUPS == 1 )
+
+/* The event list item value of a waiting task holds the bits it is waiting
+for in the bottom byte and these control bits above them.  When the task is
+woken the bottom byte is replaced with the event bits at the time. */
+#define eventCLEAR_EVENTS_ON_EXIT_BIT	( ( portTickType ) 0x0100U )
+#define eventWAIT_FOR_ALL_BITS			( ( portTickType ) 0x0200U )
+#define eventUNBLOCKED_DUE_TO_BIT_SET	( ( portTickType ) 0x0400U )
+#define eventEVENT_BITS_MASK			( ( portTickType ) 0x00ffU )
+
+typedef struct EventGroupDefinition
+{
+	volatile xEventBits uxEventBits;
+	xList xTasksWaitingForBits;			/*< Tasks blocked in xEventGroupWaitBits(), in no particular order. */
+} xEVENT_GROUP;
+
+/*
+ * Returns pdTRUE if uxCurrentBits satisfy a wait for uxBitsToWaitFor.
+ */
+static portBASE_TYPE prvTestWaitCondition( xEventBits uxCurrentBits, xEventBits uxBitsToWaitFor, portBASE_TYPE xWaitForAllBits );
+
+/*
+ * The part of xEventGroupSetBits() shared with the FromISR version.  Must be
+ * called with interrupts masked.  Returns pdTRUE if a woken task has a
+ * priority at least as high as the running task.
+ */
+static portBASE_TYPE prvSetBitsAndWake( xEVENT_GROUP *pxEventBits, xEventBits uxBitsToSet );
+
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvTestWaitCondition( xEventBits uxCurrentBits, xEventBits uxBitsToWaitFor, portBASE_TYPE xWaitForAllBits )
+{
+portBASE_TYPE xReturn = pdFALSE;
+
+	if( xWaitForAllBits == pdFALSE )
+	{
+		if( ( uxCurrentBits & uxBitsToWaitFor ) != ( xEventBits ) 0 )
+		{
+			xReturn = pdTRUE;
+		}
+	}
+	else
+	{
+		if( ( uxCurrentBits & uxBitsToWaitFor ) == uxBitsToWaitFor )
+		{
+			xReturn = pdTRUE;
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+xEventGroupHandle xEventGroupCreate( void )
+{
+xEVENT_GROUP *pxEventBits;
+
+	pxEventBits = ( xEVENT_GROUP * ) pvPortMalloc( sizeof( xEVENT_GROUP ) );
+	if( pxEventBits != NULL )
+	{
+		pxEventBits->uxEventBits = ( xEventBits ) 0;
+		vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+	}
+
+	configASSERT( pxEventBits );
+
+	return ( xEventGroupHandle ) pxEventBits;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupWaitBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToWaitFor, portBASE_TYPE xClearOnExit, portBASE_TYPE xWaitForAllBits, portTickType xTicksToWait )
+{
+xEVENT_GROUP *pxEventBits = ( xEVENT_GROUP * ) xEventGroup;
+xEventBits uxReturn;
+portTickType xControlBits = ( portTickType ) 0U;
+portBASE_TYPE xWaitSatisfied;
+
+	configASSERT( xEventGroup );
+	configASSERT( uxBitsToWaitFor != ( xEventBits ) 0 );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = pxEventBits->uxEventBits;
+		xWaitSatisfied = prvTestWaitCondition( uxReturn, uxBitsToWaitFor, xWaitForAllBits );
+
+		if( xWaitSatisfied != pdFALSE )
+		{
+			/* No need to block. */
+			if( xClearOnExit != pdFALSE )
+			{
+				pxEventBits->uxEventBits &= ( xEventBits ) ~uxBitsToWaitFor;
+			}
+			xTicksToWait = ( portTickType ) 0;
+		}
+		else if( xTicksToWait > ( portTickType ) 0 )
+		{
+			if( xClearOnExit != pdFALSE )
+			{
+				xControlBits |= eventCLEAR_EVENTS_ON_EXIT_BIT;
+			}
+
+			if( xWaitForAllBits != pdFALSE )
+			{
+				xControlBits |= eventWAIT_FOR_ALL_BITS;
+			}
+
+			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( ( portTickType ) uxBitsToWaitFor ) | xControlBits, xTicksToWait );
+
+			/* The task runs again from here, still inside the critical
+			section, once the bits are set or the block time expires. */
+			portYIELD_WITHIN_API();
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( xTicksToWait > ( portTickType ) 0 )
+	{
+		xControlBits = uxTaskResetEventItemValue();
+
+		if( ( xControlBits & eventUNBLOCKED_DUE_TO_BIT_SET ) != ( portTickType ) 0 )
+		{
+			/* Woken by xEventGroupSetBits(), which stored the bits that
+			woke the task and already did any clearing. */
+			uxReturn = ( xEventBits ) ( xControlBits & eventEVENT_BITS_MASK );
+		}
+		else
+		{
+			/* Timed out.  The bits may have been set in the meantime
+			without this task being woken, so check once more. */
+			taskENTER_CRITICAL();
+			{
+				uxReturn = pxEventBits->uxEventBits;
+
+				if( ( xClearOnExit != pdFALSE ) && ( prvTestWaitCondition( uxReturn, uxBitsToWaitFor, xWaitForAllBits ) != pdFALSE ) )
+				{
+					pxEventBits->uxEventBits &= ( xEventBits ) ~uxBitsToWaitFor;
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvSetBitsAndWake( xEVENT_GROUP *pxEventBits, xEventBits uxBitsToSet )
+{
+xListItem *pxListItem, *pxNext;
+xListItem const *pxListEnd;
+portTickType xItemValue;
+xEventBits uxBitsToClear = ( xEventBits ) 0, uxBitsWaitedFor;
+portBASE_TYPE xWaitForAllBits, xYieldRequired = pdFALSE;
+
+	pxListEnd = ( xListItem const * ) &( pxEventBits->xTasksWaitingForBits.xListEnd );
+	pxListItem = ( xListItem * ) pxEventBits->xTasksWaitingForBits.xListEnd.pxNext;
+
+	pxEventBits->uxEventBits |= uxBitsToSet;
+
+	while( pxListItem != pxListEnd )
+	{
+		/* Removing the item from the list changes its links, so find the
+		next one first. */
+		pxNext = ( xListItem * ) pxListItem->pxNext;
+		xItemValue = listGET_LIST_ITEM_VALUE( pxListItem );
+		uxBitsWaitedFor = ( xEventBits ) ( xItemValue & eventEVENT_BITS_MASK );
+
+		if( ( xItemValue & eventWAIT_FOR_ALL_BITS ) != ( portTickType ) 0 )
+		{
+			xWaitForAllBits = pdTRUE;
+		}
+		else
+		{
+			xWaitForAllBits = pdFALSE;
+		}
+
+		if( prvTestWaitCondition( pxEventBits->uxEventBits, uxBitsWaitedFor, xWaitForAllBits ) != pdFALSE )
+		{
+			/* Bits are only cleared after every waiting task has been
+			tested, so all tasks see the same set of bits. */
+			if( ( xItemValue & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( portTickType ) 0 )
+			{
+				uxBitsToClear |= uxBitsWaitedFor;
+			}
+
+			if( xTaskRemoveFromUnorderedEventList( pxListItem, ( ( portTickType ) pxEventBits->uxEventBits ) | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+			{
+				xYieldRequired = pdTRUE;
+			}
+		}
+
+		pxListItem = pxNext;
+	}
+
+	pxEventBits->uxEventBits &= ( xEventBits ) ~uxBitsToClear;
+
+	return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupSetBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToSet )
+{
+xEVENT_GROUP *pxEventBits = ( xEVENT_GROUP * ) xEventGroup;
+xEventBits uxReturn;
+
+	configASSERT( xEventGroup );
+
+	taskENTER_CRITICAL();
+	{
+		if( prvSetBitsAndWake( pxEventBits, uxBitsToSet ) != pdFALSE )
+		{
+			/* Ok to yield from within the critical section - see
+			xQueueGenericSend(). */
+			portYIELD_WITHIN_API();
+		}
+
+		uxReturn = pxEventBits->uxEventBits;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupSetBitsFromISR( xEventGroupHandle xEventGroup, xEventBits uxBitsToSet, signed portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+xEVENT_GROUP *pxEventBits = ( xEVENT_GROUP * ) xEventGroup;
+xEventBits uxReturn;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( xEventGroup );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( ( prvSetBitsAndWake( pxEventBits, uxBitsToSet ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+
+		uxReturn = pxEventBits->uxEventBits;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+xEventBits xEventGroupClearBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToClear )
+{
+xEVENT_GROUP *pxEventBits = ( xEVENT_GROUP * ) xEventGroup;
+xEventBits uxReturn;
+
+	configASSERT( xEventGroup );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = pxEventBits->uxEventBits;
+		pxEventBits->uxEventBits &= ( xEventBits ) ~uxBitsToClear;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+}
+
+#endif /* configUSE_EVENT_GROUPS */
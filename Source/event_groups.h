@@ -0,0 +1,84 @@
+/*
+ * Event groups.
+ *
+ * An event group is a set of eight event bits.  Tasks can block until one or
+ * all of a chosen set of bits are set, and are woken on the exact call that
+ * sets them, so there is no need to poll a flag from a periodic task.  Bits
+ * can be set from tasks and, through xEventGroupSetBitsFromISR(), from
+ * interrupts.
+ *
+ * Waiting tasks are woken directly from xEventGroupSetBits(), inside a
+ * critical section, so the time spent with interrupts disabled grows with the
+ * number of tasks waiting on the group.  That is bounded by the number of
+ * tasks in the application.
+ *
+ * FreeRTOS.h and task.h must be included before this file.
+ */
+#ifndef EVENT_GROUPS_H
+#define EVENT_GROUPS_H
+
+#ifndef configUSE_EVENT_GROUPS
+	#define configUSE_EVENT_GROUPS 1
+#endif
+
+typedef void * xEventGroupHandle;
+typedef unsigned char xEventBits;
+
+#if ( configUSE_EVENT_GROUPS == 1 )
+
+	/*
+	 * Create a new event group with all bits clear.  Returns NULL if the
+	 * group could not be allocated.
+	 */
+	xEventGroupHandle xEventGroupCreate( void );
+
+	/*
+	 * Block until any (xWaitForAllBits == pdFALSE) or all (pdTRUE) of
+	 * uxBitsToWaitFor are set, or xTicksToWait expires.  If xClearOnExit is
+	 * pdTRUE and the wait was satisfied, uxBitsToWaitFor are cleared before
+	 * returning.  Returns the bits as they were when the wait ended - the
+	 * caller can check them to tell a timeout from success.
+	 */
+	xEventBits xEventGroupWaitBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToWaitFor, portBASE_TYPE xClearOnExit, portBASE_TYPE xWaitForAllBits, portTickType xTicksToWait );
+
+	/*
+	 * Set uxBitsToSet and wake every task whose wait is now satisfied.
+	 * Returns the bits after waiting tasks have been woken and any clear on
+	 * exit bits cleared.
+	 */
+	xEventBits xEventGroupSetBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToSet );
+
+	/*
+	 * As xEventGroupSetBits(), for use from an ISR.  *pxHigherPriorityTaskWoken
+	 * is set to pdTRUE if a task with a higher priority than the interrupted
+	 * task was woken.
+	 */
+	xEventBits xEventGroupSetBitsFromISR( xEventGroupHandle xEventGroup, xEventBits uxBitsToSet, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+	/*
+	 * Clear uxBitsToClear.  Returns the bits as they were before clearing.
+	 */
+	xEventBits xEventGroupClearBits( xEventGroupHandle xEventGroup, xEventBits uxBitsToClear );
+
+	#define xEventGroupGetBits( xEventGroup ) xEventGroupClearBits( ( xEventGroup ), ( xEventBits ) 0 )
+
+	/*
+	 * Kernel functions used by event_groups.c and implemented in tasks.c.
+	 * Not for use by application code.
+	 *
+	 * vTaskPlaceOnUnorderedEventList() stores xItemValue in the calling task's
+	 * event list item and blocks it on pxEventList.  Must be called from a
+	 * critical section.
+	 *
+	 * xTaskRemoveFromUnorderedEventList() unblocks the task owning
+	 * pxEventListItem, leaving xItemValue in the item for the task to read
+	 * back with uxTaskResetEventItemValue().  Returns pdTRUE if the woken task
+	 * has a priority at least as high as the calling task.
+	 */
+	void vTaskPlaceOnUnorderedEventList( xList *pxEventList, portTickType xItemValue, portTickType xTicksToWait );
+	signed portBASE_TYPE xTaskRemoveFromUnorderedEventList( xListItem *pxEventListItem, portTickType xItemValue );
+	portTickType uxTaskResetEventItemValue( void );
+
+#endif
+
+#endif /* EVENT_GROUPS_H */
@@ -0,0 +1,547 @@
+/*
+ * Two level segregated fit (TLSF) implementation of pvPortMalloc() and
+ * vPortFree().  Unlike heap_1.c memory can be freed again, and neighbouring
+ * free blocks are coalesced as soon as they are released.
+ *
+ * Free blocks are kept in heapFL_INDEX_COUNT x heapSL_INDEX_COUNT lists.  The
+ * first level splits sizes by power of two, the second level splits each
+ * power of two range into four.  Two bitmaps record which lists are non-empty
+ * so finding a large enough block never walks a list - both pvPortMalloc()
+ * and vPortFree() do a bounded amount of work regardless of how fragmented
+ * the heap is.  That matters here because the work is done with the scheduler
+ * suspended.
+ *
+ * Build with configUSE_TLSF_HEAP set to 1 (heap_1.c is then excluded).  See
+ * heap_tlsf.h for the statistics API.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_tlsf.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_TLSF_HEAP == 1 )
+
+/* Four second level lists per first level class. */
+#define heapSL_INDEX_COUNT_LOG2		( 2 )
+#define heapSL_INDEX_COUNT			( 1 << heapSL_INDEX_COUNT_LOG2 )
+
+/* Block sizes are kept as a multiple of four so the bottom bits of xSize are
+free to hold flags. */
+#define heapBLOCK_GRANULE			( ( size_t ) 4 )
+#define heapBLOCK_GRANULE_MASK		( heapBLOCK_GRANULE - 1 )
+#define heapBLOCK_FREE				( ( size_t ) 0x01 )
+
+/* Sizes below this all share first level class 0. */
+#define heapFL_INDEX_SHIFT			( heapSL_INDEX_COUNT_LOG2 + 2 )
+#define heapSMALL_BLOCK_SIZE		( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/*
+ * Header placed at the start of every block.  pxNextFree and pxPrevFree
+ * overlap the caller's data so are only valid while the block is free.
+ */
+typedef struct xTLSF_BLOCK
+{
+	struct xTLSF_BLOCK *pxPrevPhys;		/*< Block immediately below this one in memory, NULL for the first block. */
+	size_t xSize;						/*< Size of the block including this header, heapBLOCK_FREE set when free. */
+	struct xTLSF_BLOCK *pxNextFree;		/*< Next block in the same free list. */
+	struct xTLSF_BLOCK *pxPrevFree;		/*< Previous block in the same free list. */
+} xTLSFBlock;
+
+/* Only pxPrevPhys and xSize are kept while a block is allocated. */
+#define heapBLOCK_OVERHEAD		( ( size_t ) ( sizeof( struct xTLSF_BLOCK * ) + sizeof( size_t ) ) )
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( ( sizeof( xTLSFBlock ) + heapBLOCK_GRANULE_MASK ) & ~heapBLOCK_GRANULE_MASK ) )
+
+#define prvBlockSize( pxBlock )		( ( pxBlock )->xSize & ~heapBLOCK_GRANULE_MASK )
+#define prvBlockIsFree( pxBlock )	( ( ( pxBlock )->xSize & heapBLOCK_FREE ) != 0 )
+#define prvNextPhys( pxBlock )		( ( xTLSFBlock * ) ( ( ( unsigned char * ) ( pxBlock ) ) + prvBlockSize( pxBlock ) ) )
+
+/* Allocate the memory for the heap.  The struct is used to force byte
+alignment without using any non-portable code. */
+static union xRTOS_HEAP
+{
+	#if portBYTE_ALIGNMENT == 8
+		volatile portDOUBLE dDummy;
+	#else
+		volatile unsigned long ulDummy;
+	#endif
+	unsigned char ucHeap[ configTOTAL_HEAP_SIZE ];
+} xHeap;
+
+/* Heads of the free lists and the bitmaps saying which of them are in use. */
+static xTLSFBlock *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static unsigned short usFLBitmap = 0U;
+static unsigned char ucSLBitmap[ heapFL_INDEX_COUNT ];
+
+static size_t xFreeBytesRemaining = ( size_t ) 0;
+static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0;
+static portBASE_TYPE xHeapHasBeenInitialised = pdFALSE;
+
+#if ( configTLSF_HEAP_STATS == 1 )
+	static xHeapClassStats xClassStats[ heapFL_INDEX_COUNT ];
+	static unsigned short usFailedAllocations = 0U;
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Carve the heap array into one free block followed by a permanently
+ * allocated end marker, so every real block has a physical successor.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Index of the highest / lowest set bit.  Both loops are bounded by the
+ * width of the argument.
+ */
+static unsigned char prvHighestBit( size_t xValue );
+static unsigned char prvLowestBit( unsigned short usValue );
+
+/*
+ * Find the list a block of xSize bytes belongs in.
+ */
+static void prvMappingInsert( size_t xSize, unsigned char *pucFL, unsigned char *pucSL );
+
+/*
+ * Find the first list whose blocks are all at least xSize bytes, and return
+ * the head of the first non-empty list at or above it.
+ */
+static xTLSFBlock *prvSearchSuitableBlock( size_t xSize );
+
+static void prvInsertFreeBlock( xTLSFBlock *pxBlock );
+static void prvRemoveFreeBlock( xTLSFBlock *pxBlock );
+
+/*-----------------------------------------------------------*/
+
+static unsigned char prvHighestBit( size_t xValue )
+{
+unsigned char ucBit = 0U;
+
+	while( xValue > ( size_t ) 1 )
+	{
+		xValue >>= 1;
+		ucBit++;
+	}
+
+	return ucBit;
+}
+/*-----------------------------------------------------------*/
+
+static unsigned char prvLowestBit( unsigned short usValue )
+{
+unsigned char ucBit = 0U;
+
+	/* Callers never pass zero. */
+	while( ( usValue & 0x01U ) == 0U )
+	{
+		usValue >>= 1;
+		ucBit++;
+	}
+
+	return ucBit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize, unsigned char *pucFL, unsigned char *pucSL )
+{
+unsigned char ucFL;
+
+	if( xSize < heapSMALL_BLOCK_SIZE )
+	{
+		*pucFL = 0U;
+		*pucSL = ( unsigned char ) ( xSize / ( heapSMALL_BLOCK_SIZE / heapSL_INDEX_COUNT ) );
+	}
+	else
+	{
+		ucFL = prvHighestBit( xSize );
+		*pucSL = ( unsigned char ) ( ( xSize >> ( ucFL - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT );
+		*pucFL = ( unsigned char ) ( ucFL - ( heapFL_INDEX_SHIFT - 1 ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static xTLSFBlock *prvSearchSuitableBlock( size_t xSize )
+{
+unsigned char ucFL, ucSL;
+unsigned short usFLMap;
+unsigned char ucSLMap;
+
+	/* Round up to the next list boundary so that any block found in the
+	chosen list is big enough - this is what removes the need to walk it. */
+	if( xSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xSize += ( ( size_t ) 1 << ( prvHighestBit( xSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1;
+	}
+
+	prvMappingInsert( xSize, &ucFL, &ucSL );
+
+	if( ucFL >= heapFL_INDEX_COUNT )
+	{
+		return NULL;
+	}
+
+	ucSLMap = ( unsigned char ) ( ucSLBitmap[ ucFL ] & ( 0xffU << ucSL ) );
+
+	if( ucSLMap == 0U )
+	{
+		/* Nothing in this class, move to the next non-empty class. */
+		usFLMap = ( unsigned short ) ( usFLBitmap & ( 0xffffU << ( ucFL + 1U ) ) );
+
+		if( usFLMap == 0U )
+		{
+			return NULL;
+		}
+
+		ucFL = prvLowestBit( usFLMap );
+		ucSLMap = ucSLBitmap[ ucFL ];
+	}
+
+	ucSL = prvLowestBit( ucSLMap );
+
+	return pxFreeLists[ ucFL ][ ucSL ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( xTLSFBlock *pxBlock )
+{
+unsigned char ucFL, ucSL;
+
+	prvMappingInsert( prvBlockSize( pxBlock ), &ucFL, &ucSL );
+
+	pxBlock->pxPrevFree = NULL;
+	pxBlock->pxNextFree = pxFreeLists[ ucFL ][ ucSL ];
+
+	if( pxBlock->pxNextFree != NULL )
+	{
+		pxBlock->pxNextFree->pxPrevFree = pxBlock;
+	}
+
+	pxFreeLists[ ucFL ][ ucSL ] = pxBlock;
+	usFLBitmap |= ( unsigned short ) ( 1U << ucFL );
+	ucSLBitmap[ ucFL ] |= ( unsigned char ) ( 1U << ucSL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( xTLSFBlock *pxBlock )
+{
+unsigned char ucFL, ucSL;
+
+	prvMappingInsert( prvBlockSize( pxBlock ), &ucFL, &ucSL );
+
+	if( pxBlock->pxNextFree != NULL )
+	{
+		pxBlock->pxNextFree->pxPrevFree = pxBlock->pxPrevFree;
+	}
+
+	if( pxBlock->pxPrevFree != NULL )
+	{
+		pxBlock->pxPrevFree->pxNextFree = pxBlock->pxNextFree;
+	}
+	else
+	{
+		/* It was the head of the list. */
+		pxFreeLists[ ucFL ][ ucSL ] = pxBlock->pxNextFree;
+
+		if( pxBlock->pxNextFree == NULL )
+		{
+			ucSLBitmap[ ucFL ] &= ( unsigned char ) ~( 1U << ucSL );
+
+			if( ucSLBitmap[ ucFL ] == 0U )
+			{
+				usFLBitmap &= ( unsigned short ) ~( 1U << ucFL );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+xTLSFBlock *pxFirstBlock, *pxEndMarker;
+size_t xUsableSize;
+
+	/* Leave room for the end marker and keep the size a multiple of the
+	granule. */
+	xUsableSize = ( ( size_t ) configTOTAL_HEAP_SIZE - heapBLOCK_OVERHEAD ) & ~heapBLOCK_GRANULE_MASK;
+
+	pxFirstBlock = ( xTLSFBlock * ) xHeap.ucHeap;
+	pxFirstBlock->pxPrevPhys = NULL;
+	pxFirstBlock->xSize = xUsableSize | heapBLOCK_FREE;
+
+	/* The end marker is never free so is never merged. */
+	pxEndMarker = prvNextPhys( pxFirstBlock );
+	pxEndMarker->pxPrevPhys = pxFirstBlock;
+	pxEndMarker->xSize = heapBLOCK_GRANULE;
+
+	prvInsertFreeBlock( pxFirstBlock );
+
+	xFreeBytesRemaining = xUsableSize;
+	xMinimumEverFreeBytesRemaining = xUsableSize;
+	xHeapHasBeenInitialised = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+xTLSFBlock *pxBlock, *pxRemainder;
+size_t xBlockSize;
+void *pvReturn = NULL;
+
+	/* Add the header and round up to the granule, checking for overflow. */
+	xBlockSize = ( xWantedSize + heapBLOCK_OVERHEAD + heapBLOCK_GRANULE_MASK ) & ~heapBLOCK_GRANULE_MASK;
+
+	if( xBlockSize < heapMINIMUM_BLOCK_SIZE )
+	{
+		xBlockSize = heapMINIMUM_BLOCK_SIZE;
+	}
+
+	vTaskSuspendAll();
+	{
+		if( xHeapHasBeenInitialised == pdFALSE )
+		{
+			prvHeapInit();
+		}
+
+		/* The free byte check also keeps the rounding done by
+		prvSearchSuitableBlock() from overflowing. */
+		if( ( xWantedSize > ( size_t ) 0 ) && ( xBlockSize > xWantedSize ) && ( xBlockSize <= xFreeBytesRemaining ) )
+		{
+			pxBlock = prvSearchSuitableBlock( xBlockSize );
+
+			if( pxBlock != NULL )
+			{
+				prvRemoveFreeBlock( pxBlock );
+
+				/* Give whatever is left back to the heap if it is big enough
+				to be a block in its own right. */
+				if( ( prvBlockSize( pxBlock ) - xBlockSize ) >= heapMINIMUM_BLOCK_SIZE )
+				{
+					pxRemainder = ( xTLSFBlock * ) ( ( ( unsigned char * ) pxBlock ) + xBlockSize );
+					pxRemainder->pxPrevPhys = pxBlock;
+					pxRemainder->xSize = ( prvBlockSize( pxBlock ) - xBlockSize ) | heapBLOCK_FREE;
+					prvNextPhys( pxRemainder )->pxPrevPhys = pxRemainder;
+					prvInsertFreeBlock( pxRemainder );
+
+					pxBlock->xSize = xBlockSize;
+				}
+				else
+				{
+					pxBlock->xSize = prvBlockSize( pxBlock );
+				}
+
+				xFreeBytesRemaining -= prvBlockSize( pxBlock );
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+
+				#if ( configTLSF_HEAP_STATS == 1 )
+				{
+				unsigned char ucFL, ucSL;
+
+					prvMappingInsert( prvBlockSize( pxBlock ), &ucFL, &ucSL );
+					xClassStats[ ucFL ].usAllocations++;
+					xClassStats[ ucFL ].usBlocksInUse++;
+				}
+				#endif
+
+				pvReturn = ( void * ) ( ( ( unsigned char * ) pxBlock ) + heapBLOCK_OVERHEAD );
+			}
+		}
+
+		#if ( configTLSF_HEAP_STATS == 1 )
+		{
+			if( pvReturn == NULL )
+			{
+				usFailedAllocations++;
+			}
+		}
+		#endif
+	}
+	xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+xTLSFBlock *pxBlock, *pxNeighbour;
+
+	if( pv == NULL )
+	{
+		return;
+	}
+
+	pxBlock = ( xTLSFBlock * ) ( ( ( unsigned char * ) pv ) - heapBLOCK_OVERHEAD );
+
+	vTaskSuspendAll();
+	{
+		xFreeBytesRemaining += prvBlockSize( pxBlock );
+
+		#if ( configTLSF_HEAP_STATS == 1 )
+		{
+		unsigned char ucFL, ucSL;
+
+			prvMappingInsert( prvBlockSize( pxBlock ), &ucFL, &ucSL );
+			xClassStats[ ucFL ].usBlocksInUse--;
+		}
+		#endif
+
+		/* Merge with the block above.  The end marker is never free so this
+		cannot run off the end of the heap. */
+		pxNeighbour = prvNextPhys( pxBlock );
+
+		if( prvBlockIsFree( pxNeighbour ) )
+		{
+			prvRemoveFreeBlock( pxNeighbour );
+			pxBlock->xSize = prvBlockSize( pxBlock ) + prvBlockSize( pxNeighbour );
+			prvNextPhys( pxBlock )->pxPrevPhys = pxBlock;
+		}
+
+		/* Merge with the block below. */
+		pxNeighbour = pxBlock->pxPrevPhys;
+
+		if( ( pxNeighbour != NULL ) && prvBlockIsFree( pxNeighbour ) )
+		{
+			prvRemoveFreeBlock( pxNeighbour );
+			pxNeighbour->xSize = prvBlockSize( pxNeighbour ) + prvBlockSize( pxBlock );
+			pxBlock = pxNeighbour;
+			prvNextPhys( pxBlock )->pxPrevPhys = pxBlock;
+		}
+
+		pxBlock->xSize |= heapBLOCK_FREE;
+		prvInsertFreeBlock( pxBlock );
+	}
+	xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetLargestFreeBlockSize( void )
+{
+xTLSFBlock *pxBlock;
+size_t xLargest = ( size_t ) 0;
+unsigned char ucFL, ucSL;
+
+	vTaskSuspendAll();
+	{
+		if( usFLBitmap != 0U )
+		{
+			/* Only the highest non-empty list can hold the largest block, but
+			its blocks are not sorted so that one list has to be walked.  This
+			is a diagnostic so the walk is acceptable here. */
+			ucFL = prvHighestBit( usFLBitmap );
+			ucSL = prvHighestBit( ucSLBitmap[ ucFL ] );
+
+			for( pxBlock = pxFreeLists[ ucFL ][ ucSL ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFree )
+			{
+				if( prvBlockSize( pxBlock ) > xLargest )
+				{
+					xLargest = prvBlockSize( pxBlock );
+				}
+			}
+
+			xLargest -= heapBLOCK_OVERHEAD;
+		}
+	}
+	xTaskResumeAll();
+
+	return xLargest;
+}
+/*-----------------------------------------------------------*/
+
+unsigned char ucPortGetHeapFragmentation( void )
+{
+size_t xFree, xLargest;
+
+	/* Both values have to come from the same state of the heap, or an
+	allocation in between could make the largest block bigger than what is
+	free.  The scheduler suspends nest. */
+	vTaskSuspendAll();
+	{
+		xLargest = xPortGetLargestFreeBlockSize();
+		xFree = xFreeBytesRemaining;
+	}
+	( void ) xTaskResumeAll();
+
+	if( xFree == ( size_t ) 0 )
+	{
+		return 0U;
+	}
+
+	/* xFree counts block headers, xLargest does not, so add the one header
+	back before comparing. */
+	xLargest += heapBLOCK_OVERHEAD;
+
+	if( xLargest >= xFree )
+	{
+		return 0U;
+	}
+
+	return ( unsigned char ) ( 100U - ( unsigned char ) ( ( ( unsigned long ) xLargest * 100UL ) / ( unsigned long ) xFree ) );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configTLSF_HEAP_STATS == 1 )
+
+	portBASE_TYPE xPortGetHeapClassStats( unsigned portBASE_TYPE uxClass, xHeapClassStats *pxStats )
+	{
+		if( uxClass >= ( unsigned portBASE_TYPE ) heapFL_INDEX_COUNT )
+		{
+			return pdFALSE;
+		}
+
+		vTaskSuspendAll();
+		{
+			*pxStats = xClassStats[ uxClass ];
+		}
+		xTaskResumeAll();
+
+		return pdTRUE;
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned short usPortGetFailedAllocations( void )
+	{
+		return usFailedAllocations;
+	}
+
+#endif /* configTLSF_HEAP_STATS */
+
+#endif /* configUSE_TLSF_HEAP */
@@ -0,0 +1,66 @@
+/*
+ * Extra heap API provided by heap_tlsf.c.  Only available when
+ * configUSE_TLSF_HEAP is set to 1, in which case heap_1.c compiles to nothing.
+ */
+#ifndef HEAP_TLSF_H
+#define HEAP_TLSF_H
+
+#include <stddef.h>
+
+/* Set configUSE_TLSF_HEAP to 1 in FreeRTOSConfig.h to build heap_tlsf.c in
+place of heap_1.c. */
+#ifndef configUSE_TLSF_HEAP
+	#define configUSE_TLSF_HEAP 0
+#endif
+
+/* Per class counters cost 4 bytes of RAM per class. */
+#ifndef configTLSF_HEAP_STATS
+	#define configTLSF_HEAP_STATS 1
+#endif
+
+/* Number of first level size classes.  Class 0 holds blocks below 16 bytes,
+class n (n > 0) holds blocks of 2^(n+3) up to 2^(n+4) - 1 bytes. */
+#define heapFL_INDEX_COUNT		( 13 )
+
+typedef struct xHEAP_CLASS_STATS
+{
+	unsigned short usAllocations;		/*< Successful allocations served from this class since start up. */
+	unsigned short usBlocksInUse;		/*< Allocated blocks of this class that have not been freed yet. */
+} xHeapClassStats;
+
+/*
+ * Lowest value xPortGetFreeHeapSize() has returned since start up.
+ */
+size_t xPortGetMinimumEverFreeHeapSize( void );
+
+/*
+ * Size of the largest free block, less its header.  This is not a promise
+ * that pvPortMalloc() of that size will succeed: the search rounds a
+ * request up to the start of the next size class, so a request close to
+ * the size of the largest block can fail when no bigger block is free.
+ * Requests at least a size class smaller are always satisfied.
+ */
+size_t xPortGetLargestFreeBlockSize( void );
+
+/*
+ * External fragmentation in percent: 0 when all free memory is one block,
+ * approaching 100 when it is spread over many small blocks.
+ */
+unsigned char ucPortGetHeapFragmentation( void );
+
+#if ( configTLSF_HEAP_STATS == 1 )
+
+	/*
+	 * Copies the statistics of first level class uxClass into *pxStats.
+	 * Returns pdFALSE if uxClass is out of range.
+	 */
+	portBASE_TYPE xPortGetHeapClassStats( unsigned portBASE_TYPE uxClass, xHeapClassStats *pxStats );
+
+	/*
+	 * Number of calls to pvPortMalloc() that returned NULL.
+	 */
+	unsigned short usPortGetFailedAllocations( void );
+
+#endif
+
+#endif /* HEAP_TLSF_H */
@@ -0,0 +1,92 @@
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heartbeat.h"
+
+volatile uint8_t hb_bpm = 0;
+volatile uint8_t hb_confidence = 0;
+volatile uint8_t hb_valid = 0;
+
+static portTickType hb_last; // tick of the last accepted beat
+static uint8_t hb_have_last = 0;
+static uint16_t hb_ibi[HB_HISTORY]; // inter beat intervals in ms
+static uint8_t hb_count = 0; // intervals in hb_ibi
+static uint8_t hb_next = 0;
+
+void heartbeat_reset(void) {
+	/* the input task is higher priority and could run heartbeat_beat halfway through */
+	taskENTER_CRITICAL();
+	hb_have_last = 0;
+	hb_count = 0;
+	hb_next = 0;
+	hb_bpm = 0;
+	hb_confidence = 0;
+	hb_valid = 0;
+	taskEXIT_CRITICAL();
+}
+
+/* A beat is accepted when it comes HB_MIN_IBI_MS to HB_MAX_IBI_MS after the
+last one. It counts as valid when the interval is also within 25% of the
+average so far. Fixed work per beat, all in task context; the ISR only
+records the edge. */
+void heartbeat_beat(portTickType tick) {
+	uint32_t ibi;
+	uint32_t sum = 0;
+	uint32_t dev = 0;
+	uint16_t mean;
+	uint8_t i;
+
+	if(!hb_have_last) {
+		hb_last = tick;
+		hb_have_last = 1;
+		return;
+	}
+
+	ibi = (uint32_t)(portTickType)(tick - hb_last) * portTICK_RATE_MS;
+	if(ibi < HB_MIN_IBI_MS) { // too soon, noise on the sensor
+		return;
+	}
+	hb_last = tick;
+	if(ibi > HB_MAX_IBI_MS) { // lost the pulse, start again from this beat
+		hb_count = 0;
+		hb_next = 0;
+		hb_valid = 0;
+		hb_bpm = 0;
+		hb_confidence = 0;
+		return;
+	}
+
+	for(i = 0; i < hb_count; i++) {
+		sum += hb_ibi[i];
+	}
+	if(hb_count > 0) {
+		mean = sum / hb_count;
+		if((ibi * 4 < (uint32_t)mean * 3) || (ibi * 4 > (uint32_t)mean * 5)) { // off by more than 25%
+			hb_valid = 0;
+		}
+		else if(hb_valid < 255) {
+			hb_valid++;
+		}
+	}
+	else {
+		hb_valid = 1;
+	}
+
+	hb_ibi[hb_next] = ibi;
+	hb_next = (hb_next + 1) & (HB_HISTORY - 1);
+	if(hb_count < HB_HISTORY) {
+		hb_count++;
+	}
+
+	sum = 0;
+	for(i = 0; i < hb_count; i++) {
+		sum += hb_ibi[i];
+	}
+	mean = sum / hb_count;
+	for(i = 0; i < hb_count; i++) {
+		dev += (hb_ibi[i] > mean) ? (hb_ibi[i] - mean) : (mean - hb_ibi[i]);
+	}
+	dev /= hb_count;
+
+	hb_bpm = 60000UL / mean;
+	hb_confidence = (dev * 4 >= mean) ? 0 : 100 - (dev * 400) / mean; // 0 once the average deviation reaches 25%
+}
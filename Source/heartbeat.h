@@ -0,0 +1,24 @@
+/* Heartbeat detection from the digital pulse sensor on PA4.
+FreeRTOS.h must be included before this file. */
+#ifndef HEARTBEAT_H
+#define HEARTBEAT_H
+
+#include <stdint.h>
+
+#define HB_MIN_BPM 40
+#define HB_MAX_BPM 200
+#define HB_MIN_IBI_MS (60000UL / HB_MAX_BPM) // closer beats are sensor noise
+#define HB_MAX_IBI_MS (60000UL / HB_MIN_BPM) // a longer gap starts over
+#define HB_HISTORY 8 // intervals averaged for bpm and confidence, power of two
+#define HB_DISMISS_BEATS 6 // valid beats in a row that turn the alarm off
+
+/* Results, written only by the input task. Each is a single byte so reads
+are atomic. */
+extern volatile uint8_t hb_bpm; // 0 until there are two valid beats
+extern volatile uint8_t hb_confidence; // 0-100, how regular the last intervals were
+extern volatile uint8_t hb_valid; // valid beats in a row, stops at 255
+
+void heartbeat_beat(portTickType tick); // sensor went active, called by the input task for each edge
+void heartbeat_reset(void); // forget everything, for a new alarm
+
+#endif
@@ -27,7 +27,7 @@ uint8_t i2c_start(uint8_t address)
 	// wait for end of transmission
 	while( !(TWCR & (1<<TWINT)) );
 	// check if the start condition was successfully transmitted
-	if((TWSR & 0xF8) != TW_START){ return 1; }
+	if(((TWSR & 0xF8) != TW_START) && ((TWSR & 0xF8) != TW_REP_START)){ return 1; }
 	// load slave address into data register
 	TWDR = address;
 	// start transmission of address
@@ -36,7 +36,7 @@ uint8_t i2c_start(uint8_t address)
 	while( !(TWCR & (1<<TWINT)) );
 	// check if the device has acknowledged the READ / WRITE mode
 	uint8_t twst = TW_STATUS & 0xF8;
-	if ( twst != TW_MT_SLA_ACK ) return 1;
+	if ( (twst != TW_MT_SLA_ACK) && (twst != TW_MR_SLA_ACK) ) return 1;
 	return 0;
 }
 
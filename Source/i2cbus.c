@@ -0,0 +1,238 @@
+#include <avr/io.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "task_notify.h"
+#include "i2c_master.h"
+#include "i2cbus.h"
+
+static xI2CXfer *bus_queue = NULL; // highest priority first
+static xTaskHandle bus_task = NULL;
+static uint8_t bus_running = 0; // set once the bus task has run, before that transfers are done inline
+static uint8_t bus_buf[I2CBUS_COALESCE_MAX];
+static xI2CStats bus_stats[I2CBUS_DEVICES];
+
+/*-------------------------------------------------------------------------*/
+
+static xI2CStats *bus_device(uint8_t addr) {
+	uint8_t i;
+	for(i = 0; i < I2CBUS_DEVICES; i++) {
+		if(bus_stats[i].addr == addr) {
+			return &bus_stats[i];
+		}
+		if(bus_stats[i].addr == 0) {
+			bus_stats[i].addr = addr;
+			return &bus_stats[i];
+		}
+	}
+	return NULL; // table full, not counted
+}
+
+/* One transfer on the wire. i2c_master busy waits on each byte, this task
+just keeps anyone else from using the bus meanwhile. */
+static uint8_t bus_run(uint8_t addr, uint8_t reg, uint8_t flags, uint8_t *data, uint8_t len) {
+	uint8_t err;
+
+	if(flags & I2C_XFER_NOREG) {
+		err = i2c_transmit(addr, data, len);
+	}
+	else if(flags & I2C_XFER_READ) {
+		err = i2c_readReg(addr, reg, data, len);
+	}
+	else {
+		err = i2c_writeReg(addr, reg, data, len);
+	}
+	if(err) {
+		i2c_stop(); // i2c_master leaves the bus as it was on an error
+	}
+	return err ? I2C_XFER_ERROR : I2C_XFER_OK;
+}
+
+static void bus_finish(xI2CXfer *x, uint8_t status, uint8_t merged) {
+	xI2CStats *st = bus_device(x->addr);
+	portTickType latency = xTaskGetTickCount() - x->queued;
+
+	if(st != NULL) {
+		st->xfers++;
+		if(status != I2C_XFER_OK) {
+			st->errors++;
+		}
+		if(merged) {
+			st->merged++;
+		}
+		if(latency > st->latency_max) {
+			st->latency_max = latency;
+		}
+		st->latency_sum += latency;
+	}
+
+	x->status = status;
+	if(x->done != NULL) {
+		x->done(x);
+	}
+	if(x->task != NULL) {
+		xTaskNotifySetBits(x->task, I2CBUS_DONE_BIT);
+	}
+}
+
+/* x is a read that has just been taken off the queue. Other queued reads
+from the same device are taken too if one read of at most
+I2CBUS_COALESCE_MAX registers covers them all. Returns 0 if nothing could
+be merged and x should be run on its own. */
+static uint8_t bus_coalesce(xI2CXfer *x) {
+	xI2CXfer *group = NULL;
+	xI2CXfer **link;
+	xI2CXfer *y;
+	uint8_t lo = x->reg;
+	uint8_t hi = x->reg + x->len;
+	uint8_t nlo, nhi, status;
+
+	if((x->flags & (I2C_XFER_READ | I2C_XFER_NOREG)) != I2C_XFER_READ) {
+		return 0;
+	}
+
+	taskENTER_CRITICAL();
+	link = &bus_queue;
+	while(*link != NULL) {
+		y = *link;
+		if(y->addr == x->addr && (y->flags & (I2C_XFER_READ | I2C_XFER_NOREG)) == I2C_XFER_READ) {
+			nlo = (y->reg < lo) ? y->reg : lo;
+			nhi = (y->reg + y->len > hi) ? y->reg + y->len : hi;
+			if(nhi - nlo <= I2CBUS_COALESCE_MAX) {
+				lo = nlo;
+				hi = nhi;
+				*link = y->next; // take it off the queue
+				y->next = group;
+				group = y;
+				continue;
+			}
+		}
+		link = &y->next;
+	}
+	taskEXIT_CRITICAL();
+
+	if(group == NULL) {
+		return 0;
+	}
+
+	status = bus_run(x->addr, lo, I2C_XFER_READ, bus_buf, hi - lo);
+	memcpy(x->data, &bus_buf[x->reg - lo], x->len);
+	bus_finish(x, status, 0);
+	while(group != NULL) {
+		y = group;
+		group = y->next;
+		memcpy(y->data, &bus_buf[y->reg - lo], y->len);
+		bus_finish(y, status, 1);
+	}
+	return 1;
+}
+
+static void BusTask(void *pvParameters) {
+	xI2CXfer *x;
+
+	(void) pvParameters;
+	bus_running = 1; // highest priority task, so this runs before anyone can submit
+
+	for(;;) {
+		taskENTER_CRITICAL();
+		x = bus_queue;
+		if(x != NULL) {
+			bus_queue = x->next;
+		}
+		taskEXIT_CRITICAL();
+
+		if(x == NULL) {
+			ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+			continue;
+		}
+		if(!bus_coalesce(x)) {
+			bus_finish(x, bus_run(x->addr, x->reg, x->flags, x->data, x->len), 0);
+		}
+	}
+}
+
+/*-------------------------------------------------------------------------*/
+
+void i2cbus_start(unsigned portBASE_TYPE Priority) {
+	i2c_init();
+	xTaskCreate(BusTask, (signed portCHAR *)"BusTask", configMINIMAL_STACK_SIZE, NULL, Priority, &bus_task);
+}
+
+void i2cbus_submit(xI2CXfer *x) {
+	xI2CXfer **link;
+
+	x->status = I2C_XFER_QUEUED;
+	x->queued = xTaskGetTickCount();
+	if(!bus_running) { // no scheduler yet, nothing else can be on the bus
+		bus_finish(x, bus_run(x->addr, x->reg, x->flags, x->data, x->len), 0);
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	link = &bus_queue;
+	while(*link != NULL && (*link)->prio >= x->prio) {
+		link = &(*link)->next;
+	}
+	x->next = *link;
+	*link = x;
+	taskEXIT_CRITICAL();
+	xTaskNotifyGive(bus_task);
+}
+
+uint8_t i2cbus_xfer(xI2CXfer *x) {
+	unsigned long value;
+	unsigned long others = 0;
+
+	x->task = bus_running ? xTaskGetCurrentTaskHandle() : NULL;
+	i2cbus_submit(x);
+	if(x->task == NULL) { // done inline
+		return x->status;
+	}
+
+	/* The bus task is above every caller, so it has usually finished the
+	transfer before i2cbus_submit returns and the done bit is already
+	pending. Wait for the bit whatever status says, or it stays pending
+	and the caller's next wait returns at once. */
+	do {
+		xTaskNotifyWait(0, I2CBUS_DONE_BIT, &value, portMAX_DELAY);
+		others |= value & ~I2CBUS_DONE_BIT;
+	} while(!(value & I2CBUS_DONE_BIT));
+	if(others) {
+		xTaskNotifySetBits(x->task, 0); // the wait used up a notification meant for the task itself, keep it pending
+	}
+	return x->status;
+}
+
+static uint8_t bus_blocking(uint8_t addr, uint8_t reg, uint8_t flags, uint8_t *data, uint8_t len, uint8_t prio) {
+	xI2CXfer x;
+	x.addr = addr;
+	x.reg = reg;
+	x.flags = flags;
+	x.data = data;
+	x.len = len;
+	x.prio = prio;
+	x.done = NULL;
+	return i2cbus_xfer(&x);
+}
+
+uint8_t i2cbus_read(uint8_t addr, uint8_t reg, uint8_t *data, uint8_t len, uint8_t prio) {
+	return bus_blocking(addr, reg, I2C_XFER_READ, data, len, prio);
+}
+
+uint8_t i2cbus_write(uint8_t addr, uint8_t reg, const uint8_t *data, uint8_t len, uint8_t prio) {
+	return bus_blocking(addr, reg, 0, (uint8_t *)data, len, prio);
+}
+
+uint8_t i2cbus_send(uint8_t addr, const uint8_t *data, uint8_t len, uint8_t prio) {
+	return bus_blocking(addr, 0, I2C_XFER_NOREG, (uint8_t *)data, len, prio);
+}
+
+const xI2CStats *i2cbus_stats(uint8_t addr) {
+	uint8_t i;
+	for(i = 0; i < I2CBUS_DEVICES; i++) {
+		if(bus_stats[i].addr == addr) {
+			return &bus_stats[i];
+		}
+	}
+	return NULL;
+}
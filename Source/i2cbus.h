@@ -0,0 +1,67 @@
+/* I2C bus manager. One task owns i2c_master and runs transfers queued by
+the rest of the program, highest priority first, so transfers from
+different tasks can not interleave on the bus. Reads from the same device
+that sit next to each other in the register map are merged into one.
+The bus task runs above every task that uses it and takes each transfer
+as soon as it is submitted, so the ordering and merging only come into
+play when a caller queues several transfers with i2cbus_submit before it
+waits. The blocking calls below always run one transfer at a time.
+FreeRTOS.h and task.h must be included before this file, and
+INCLUDE_xTaskGetCurrentTaskHandle must be 1 for i2cbus_xfer. */
+#ifndef I2CBUS_H
+#define I2CBUS_H
+
+#include <stdint.h>
+
+#define I2CBUS_PRIO_LCD 1
+#define I2CBUS_PRIO_RTC 2
+
+#define I2CBUS_COALESCE_MAX 19 // largest merged read, all of the DS3231's registers
+#define I2CBUS_DEVICES 4 // devices that get their own counters
+
+#define I2CBUS_DONE_BIT 0x80000000UL // notification bit i2cbus_xfer waits on, tasks that use it must only use bits below
+
+// xI2CXfer flags
+#define I2C_XFER_READ 0x01 // read len bytes from reg, otherwise write them
+#define I2C_XFER_NOREG 0x02 // no register address, data goes straight out (PCF8574)
+
+// xI2CXfer status
+#define I2C_XFER_QUEUED 0
+#define I2C_XFER_OK 1
+#define I2C_XFER_ERROR 2
+
+typedef struct xI2CXfer {
+	struct xI2CXfer *next; // queue link, the bus owns it while queued
+	uint8_t addr; // 8 bit write address
+	uint8_t reg;
+	uint8_t flags;
+	uint8_t len;
+	uint8_t *data; // has to stay valid until the transfer is finished
+	uint8_t prio; // higher goes first, equal ones in order
+	volatile uint8_t status;
+	xTaskHandle task; // notified with I2CBUS_DONE_BIT when finished, or NULL
+	void (*done)(struct xI2CXfer *x); // called in the bus task when finished, or NULL
+	portTickType queued; // tick it was submitted, for the latency counters
+} xI2CXfer;
+
+typedef struct {
+	uint8_t addr; // 0 for an unused entry
+	uint16_t xfers; // transfers finished, merged ones included
+	uint16_t errors; // transfers the device did not acknowledge
+	uint16_t merged; // reads that were served by another read
+	portTickType latency_max; // ticks from submit to finished
+	uint32_t latency_sum;
+} xI2CStats;
+
+void i2cbus_start(unsigned portBASE_TYPE Priority); // sets up the TWI and creates the bus task, before any transfer
+void i2cbus_submit(xI2CXfer *x); // queue x and return, status says when it is done
+uint8_t i2cbus_xfer(xI2CXfer *x); // queue x and wait for it, returns status; before the scheduler runs it is done at once
+
+/* Blocking shortcuts, return I2C_XFER_OK or I2C_XFER_ERROR */
+uint8_t i2cbus_read(uint8_t addr, uint8_t reg, uint8_t *data, uint8_t len, uint8_t prio);
+uint8_t i2cbus_write(uint8_t addr, uint8_t reg, const uint8_t *data, uint8_t len, uint8_t prio);
+uint8_t i2cbus_send(uint8_t addr, const uint8_t *data, uint8_t len, uint8_t prio); // no register byte
+
+const xI2CStats *i2cbus_stats(uint8_t addr); // 0 if the device has not been used
+
+#endif
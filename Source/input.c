@@ -0,0 +1,127 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "task_notify.h"
+#include "input.h"
+#include "heartbeat.h"
+
+volatile uint8_t in_pressed = 0;
+volatile uint8_t in_overflows = 0;
+
+/* Single producer (PCINT0_vect), single consumer (InputTask) ring. Only the
+ISR writes in_head and only the task writes in_tail, so neither side needs
+to lock the other out. */
+static xInputEdge in_ring[IN_RING_SIZE];
+static volatile uint8_t in_head = 0;
+static volatile uint8_t in_tail = 0;
+
+static uint8_t in_last; // PINA & IN_MASK as last seen by the ISR
+static xTaskHandle in_task = NULL;
+
+static void InputTask(void *pvParameters);
+
+static void input_init(void) {
+	DDRA &= ~IN_MASK;
+	PORTA |= IN_MASK; // pull-ups
+	in_last = PINA & IN_MASK;
+	PCMSK0 = IN_MASK; // PCINT2-4 are PA2-PA4
+	PCIFR = (1 << PCIF0);
+	PCICR |= (1 << PCIE0);
+}
+
+ISR(PCINT0_vect) {
+	uint8_t pins = PINA & IN_MASK;
+	uint8_t changed = pins ^ in_last;
+	uint8_t head = in_head;
+	xInputEdge *edge;
+
+	if(!changed) {
+		return;
+	}
+	in_last = pins;
+
+	if((uint8_t)(head - in_tail) >= IN_RING_SIZE) {
+		in_overflows++;
+		return;
+	}
+
+	edge = &in_ring[head & (IN_RING_SIZE - 1)];
+	edge->sub = TCNT1;
+	edge->tick = xTaskGetTickCountFromISR();
+	if(TIFR1 & (1 << OCF1A)) { // the tick interrupt is pending behind us, TCNT1 has already restarted
+		edge->tick++;
+		edge->sub = TCNT1;
+	}
+	edge->pins = pins;
+	edge->changed = changed;
+	in_head = head + 1; // publish after the entry is complete
+
+	if(in_task != NULL) {
+		vTaskNotifyGiveFromISR(in_task, NULL);
+	}
+}
+
+/* Drains the ring and debounces in task context. A level counts once it has
+not changed for IN_DEBOUNCE_TICKS. Button presses are then held for
+IN_HOLD_TICKS so the screen tasks, which only look every 200 ticks, see
+short presses too. */
+static void InputTask(void *pvParameters) {
+	uint8_t raw = IN_MASK; // nothing pressed
+	uint8_t stable = IN_MASK;
+	uint8_t held = 0;
+	portTickType last_edge = 0;
+	portTickType hold_until = 0;
+	portTickType now, wait, left;
+	xInputEdge edge;
+
+	(void) pvParameters;
+
+	for(;;) {
+		while(in_tail != in_head) {
+			edge = in_ring[in_tail & (IN_RING_SIZE - 1)];
+			in_tail++; // frees the slot for the ISR
+			raw = edge.pins;
+			last_edge = edge.tick;
+			if((edge.changed & IN_HB) && !(edge.pins & IN_HB)) { // sensor went active, timed from the raw edge
+				heartbeat_beat(edge.tick);
+			}
+		}
+
+		now = xTaskGetTickCount();
+		wait = portMAX_DELAY;
+
+		if(raw != stable) {
+			if((portTickType)(now - last_edge) >= IN_DEBOUNCE_TICKS) {
+				held |= (stable & ~raw) & (IN_LEFT | IN_RIGHT); // newly pressed buttons
+				if(held) {
+					hold_until = now + IN_HOLD_TICKS;
+				}
+				stable = raw;
+			}
+			else {
+				wait = IN_DEBOUNCE_TICKS - (portTickType)(now - last_edge);
+			}
+		}
+
+		if(held) {
+			left = hold_until - now;
+			if(left == 0 || left > IN_HOLD_TICKS) { // passed
+				held = 0;
+			}
+			else if(left < wait) {
+				wait = left;
+			}
+		}
+
+		in_pressed = (~stable & IN_MASK) | held;
+
+		ulTaskNotifyTake(pdTRUE, wait);
+	}
+}
+
+void input_start(unsigned portBASE_TYPE Priority) {
+	xTaskCreate(InputTask, (signed portCHAR *)"InputTask", configMINIMAL_STACK_SIZE, NULL, Priority, &in_task);
+	input_init(); // interrupts are still off, nothing arrives before the scheduler starts
+}
@@ -0,0 +1,32 @@
+/* LEFT, RIGHT and the heartbeat sensor, captured by PCINT0.
+FreeRTOS.h must be included before this file. */
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdint.h>
+
+// PINA bits, all active low
+#define IN_LEFT 0x04
+#define IN_RIGHT 0x08
+#define IN_HB 0x10
+#define IN_MASK (IN_LEFT | IN_RIGHT | IN_HB)
+
+#define IN_RING_SIZE 16 // power of two
+#define IN_DEBOUNCE_TICKS (20 / portTICK_RATE_MS) // an input has to be stable this long to count
+#define IN_HOLD_TICKS (250 / portTICK_RATE_MS) // a button press stays visible at least this long, longer than the 200 tick polling
+
+// One pin change interrupt. tick and sub say when it happened: sub is
+// TCNT1, the tick timer, so it counts clk / 64 steps into the tick.
+typedef struct {
+	portTickType tick;
+	uint16_t sub;
+	uint8_t pins; // PINA & IN_MASK after the change
+	uint8_t changed; // which of IN_MASK changed
+} xInputEdge;
+
+extern volatile uint8_t in_pressed; // debounced IN_ bits that are pressed, a single byte so reads are atomic
+extern volatile uint8_t in_overflows; // edges lost because the ring was full
+
+void input_start(unsigned portBASE_TYPE Priority); // creates the debounce task and enables the pin change interrupt
+
+#endif
@@ -0,0 +1,85 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include "joystick.h"
+
+volatile uint8_t joy_state = 0;
+
+void joystick_init(void) {
+	/* Timer0 only paces the ADC, its interrupt stays off */
+	TCCR0A = (1 << WGM01); // CTC
+	OCR0A = JOY_TIMER_TOP;
+	TCCR0B = (1 << CS02) | (1 << CS00); // clk / 1024
+
+	/* ADC0, reference left as it was */
+	ADMUX &= 0xE0;
+	ADCSRB = (1 << ADTS1) | (1 << ADTS0); // auto trigger on timer0 compare match A
+#if F_CPU / 64 <= 200000UL
+	ADCSRA = (1 << ADEN) | (1 << ADATE) | (1 << ADIE) | (1 << ADPS2) | (1 << ADPS1);
+#else
+	ADCSRA = (1 << ADEN) | (1 << ADATE) | (1 << ADIE) | (1 << ADPS2) | (1 << ADPS1) | (1 << ADPS0);
+#endif
+	// ADEN: Enables analog-to-digital conversion
+	// ADATE: Conversions start on the trigger above instead of running free
+	// ADIE: ADC_vect when a conversion completes
+	// ADPS: clk / 64, 125kHz ADC clock at 8MHz, a conversion takes 104us;
+	// clk / 128 above 12.8MHz to stay under the ADC's 200kHz
+}
+
+void joystick_idle(uint8_t io_busy) {
+	/* Sleep until the conversion is done, the ADC interrupt wakes us. With
+	JOY_ADC_SLEEP the CPU and IO clocks stop as well so they do not add
+	noise, see joystick.h for what that costs the tick. While a tone or
+	light pattern is playing its timer would stop with them, so only the
+	CPU sleeps then. */
+	cli();
+	if(ADCSRA & (1 << ADSC)) {
+		set_sleep_mode((JOY_ADC_SLEEP && !io_busy) ? SLEEP_MODE_ADC : SLEEP_MODE_IDLE);
+		sleep_enable();
+		sei();
+		sleep_cpu();
+		sleep_disable();
+	}
+	else {
+		sei();
+	}
+}
+
+ISR(ADC_vect) {
+	static uint16_t sum = 0;
+	static uint8_t count = 0;
+	static uint8_t candidate = 0;
+	static uint8_t stable = 0;
+	uint16_t reading;
+	uint8_t next = 0;
+
+	TIFR0 = (1 << OCF0A); // the trigger flag has to be cleared for the next compare match to start a conversion
+
+	sum += ADC;
+	if(++count < (1 << JOY_OVERSAMPLE_SHIFT)) {
+		return;
+	}
+	reading = sum >> JOY_OVERSAMPLE_SHIFT;
+	sum = 0;
+	count = 0;
+
+	/* hysteresis around the state being debounced */
+	if(reading > ((candidate & JOY_UP) ? JOY_UP_OFF : JOY_UP_ON)) {
+		next = JOY_UP;
+	}
+	else if(reading < ((candidate & JOY_DOWN) ? JOY_DOWN_OFF : JOY_DOWN_ON)) {
+		next = JOY_DOWN;
+	}
+
+	if(next != candidate) {
+		candidate = next;
+		stable = 1;
+	}
+	else if(stable < JOY_DEBOUNCE) {
+		stable++;
+	}
+
+	if(stable >= JOY_DEBOUNCE) {
+		joy_state = candidate;
+	}
+}
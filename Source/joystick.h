@@ -0,0 +1,44 @@
+/* Joystick up/down axis on ADC0, sampled in the background */
+#ifndef JOYSTICK_H
+#define JOYSTICK_H
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#error "F_CPU must be set for the whole build, the conversion rate depends on it"
+#endif
+
+#define JOY_UP 0x01
+#define JOY_DOWN 0x02
+
+// Raw thresholds. A direction is entered past the first value and only left
+// again once the reading comes back past the second, so a stick resting near
+// a threshold does not chatter.
+#define JOY_UP_ON 750
+#define JOY_UP_OFF 700
+#define JOY_DOWN_ON 200
+#define JOY_DOWN_OFF 250
+
+#define JOY_OVERSAMPLE_SHIFT 2 // average 4 conversions per reading
+#define JOY_DEBOUNCE 2 // readings a new state must last before it is published
+
+// Timer0 compare match A triggers the conversions, JOY_RATE a second, so
+// 50 readings a second after averaging. At 8MHz the top is 38.
+#define JOY_RATE 200
+#define JOY_TIMER_TOP (F_CPU / 1024 / JOY_RATE - 1)
+
+// 1: the idle hook sleeps in ADC noise reduction mode while a conversion
+// runs. That stops Timer1 too, so the RTOS tick loses one conversion time
+// (104us) per conversion: about 2% slow at 200 a second whenever the
+// system is idle, which skews delays, input timestamps and heart rate.
+// 0: the CPU just idles and the readings take the IO noise.
+#ifndef JOY_ADC_SLEEP
+#define JOY_ADC_SLEEP 0
+#endif
+
+extern volatile uint8_t joy_state; // JOY_UP, JOY_DOWN or 0, a single byte so reads are atomic
+
+void joystick_init(void);
+void joystick_idle(uint8_t io_busy); // call from the idle hook, sleeps while a conversion runs; io_busy 1 if a timer must keep running
+
+#endif
@@ -0,0 +1,137 @@
+// Permission to copy is granted provided that this header remains intact.
+// This software is provided with no warranties.
+
+// HD44780 protocol, shared by every transport - see lcd.h.
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include "lcd_transport.h"
+
+/*-------------------------------------------------------------------------*/
+
+void delay_ms(int miliSec) { //for 8 Mhz crystal
+	int i,j;
+	for(i=0;i<miliSec;i++) {
+		for(j=0;j<775;j++) {
+			asm("nop");
+		}
+	}
+}
+
+/*-------------------------------------------------------------------------*/
+
+static const unsigned char* LCD_CGRAM[8]; // glyph in each CGRAM slot, 0 if not known
+
+// wait for the controller to finish the last write
+static void LCD_Wait(unsigned char slow) {
+#if LCD_BUS_READS_BUSY
+	(void) slow;
+	while(lcd_bus_read_busy());
+#else
+	if(slow) {
+		_delay_ms(LCD_SLOW_MS);
+	}
+	else {
+		_delay_us(LCD_FAST_US);
+	}
+#endif
+}
+
+void LCD_WriteCommand (unsigned char Command) {
+	lcd_bus_write(0, Command);
+	LCD_Wait(Command < 0x04); // clear screen and return home are the slow ones
+}
+
+void LCD_ClearScreen(void) {
+	LCD_WriteCommand(0x01);
+}
+
+void LCD_init(void) {
+	unsigned char i;
+	for(i = 0; i < 8; i++) { // CGRAM is not cleared at power up
+		LCD_CGRAM[i] = 0;
+	}
+	lcd_bus_init();
+	_delay_ms(100); //wait for 100 ms for LCD to power up
+#if LCD_BUS_4BIT
+	// the LCD may be in 8 bit mode or halfway through a 4 bit byte, three
+	// 0x3 nibbles get it to 8 bit mode from either, then 0x2 selects 4 bit.
+	// The busy flag cannot be read yet so these use fixed waits.
+	lcd_bus_write_nibble(0x03);
+	_delay_ms(5);
+	lcd_bus_write_nibble(0x03);
+	_delay_us(150);
+	lcd_bus_write_nibble(0x03);
+	_delay_us(150);
+	lcd_bus_write_nibble(0x02);
+	_delay_us(150);
+	LCD_WriteCommand(0x28);
+#else
+	LCD_WriteCommand(0x38);
+#endif
+	LCD_WriteCommand(0x06);
+	LCD_WriteCommand(0x0f);
+	LCD_WriteCommand(0x01);
+}
+
+void LCD_WriteData(unsigned char Data) {
+	lcd_bus_write(1, Data);
+	LCD_Wait(0);
+}
+
+void LCD_Cursor(unsigned char column) {
+	if ( column < 17 ) { // 16x2 LCD: column < 17; 16x1 LCD: column < 9
+		LCD_WriteCommand(0x80 + column - 1);
+		} else { // 6x2 LCD: column - 9; 16x1 LCD: column - 1
+		LCD_WriteCommand(0xB8 + column - 9);
+	}
+}
+
+// The address is set once per run and the LCD moves the cursor on by
+// itself after every character (entry mode 0x06). Line one ends at DDRAM
+// 0x0F and line two starts at 0x40, so the run is re-addressed when it
+// crosses from column 16 to 17.
+void LCD_DisplayString( unsigned char column,  char* string) {
+	//LCD_ClearScreen();
+	unsigned char c = column;
+	LCD_Cursor(c);
+	while(*string) {
+		if(c == 17 && c != column) {
+			LCD_Cursor(c);
+		}
+		LCD_WriteData(*string++);
+		c++;
+	}
+}
+
+// As LCD_DisplayString, for a string in flash.
+void LCD_DisplayString_P( unsigned char column,  const char* string) {
+	unsigned char c = column;
+	char ch;
+	LCD_Cursor(c);
+	while((ch = pgm_read_byte(string++))) {
+		if(c == 17 && c != column) {
+			LCD_Cursor(c);
+		}
+		LCD_WriteData(ch);
+		c++;
+	}
+}
+
+void SLCD_WriteData(unsigned char column, unsigned char Data) {
+	LCD_Cursor(column);
+	LCD_WriteData(Data);
+}
+
+void LCD_LoadGlyph_P(unsigned char slot, const unsigned char* glyph) {
+	unsigned char i;
+	slot &= 0x07;
+	if(LCD_CGRAM[slot] == glyph) {
+		return;
+	}
+	LCD_WriteCommand(0x40 | (slot << 3)); // CGRAM address
+	for(i = 0; i < 8; i++) {
+		LCD_WriteData(pgm_read_byte(glyph + i));
+	}
+	LCD_CGRAM[slot] = glyph;
+}
@@ -1,108 +1,64 @@
-// Permission to copy is granted provided that this header remains intact.
-// This software is provided with no warranties.
-
-#ifndef LCD_H
-#define LCD_H
-
-#include <stdio.h>
-#include <util/delay.h>
-
-#define SET_BIT(p,i) ((p) |= (1 << (i)))
-#define CLR_BIT(p,i) ((p) &= ~(1 << (i)))
-#define GET_BIT(p,i) ((p) & (1 << (i)))
-
-/*-------------------------------------------------------------------------*/
-
-//#define DATA_BUS PORTD		// port connected to pins 7-14 of LCD display
-#define CONTROL_BUS PORTD	// port connected to pins 4 and 6 of LCD disp.
-#define RS 6			// pin number of uC connected to pin 4 of LCD disp.
-#define E 5				// pin number of uC connected to pin 6 of LCD disp.
-
-/*-------------------------------------------------------------------------*/
-
-void delay_ms(int miliSec) { //for 8 Mhz crystal
-	int i,j;
-	for(i=0;i<miliSec;i++) {
-		for(j=0;j<775;j++) {
-			asm("nop");
-		}
-	}
-}
-
-/*-------------------------------------------------------------------------*/
-
-void transmit_data(unsigned char data) {
-	/* for each bit of data */
-	for(unsigned i = 0; i < 8; i++) {
-		PORTD |= 0x01; // Set SRCLR to 1 allowing data to be set
-		PORTD &= 0xFD; // Also clear SRCLK in preparation of sending data
-		if(data & 0x80) {
-			PORTD |= 0x08;
-		}
-		else {
-			PORTD &= 0xF7;
-		}// set SER = next bit of data to be sent.
-		PORTD |= 0x02; // set SRCLK = 1. Rising edge shifts next bit of data into the shift register
-		data = data << 1;
-	}
-	/* end for each bit of data */
-	PORTD |= 0x04; // set RCLK = 1. Rising edge copies data from the "Shift" register to the "Storage" register
-	PORTD &= 0xE0;  // clears all lines in preparation of a new transmission
-}
-
-void LCD_WriteCommand (unsigned char Command) {
-	CLR_BIT(CONTROL_BUS,RS);
-	transmit_data(Command); // added
-	//DATA_BUS = Command;
-	SET_BIT(CONTROL_BUS,E);
-	asm("nop");
-	CLR_BIT(CONTROL_BUS,E);
-	delay_ms(2); // ClearScreen requires 1.52ms to execute
-}
-
-void LCD_ClearScreen(void) {
-	LCD_WriteCommand(0x01);
-}
-
-void LCD_init(void) {
-	delay_ms(100); //wait for 100 ms for LCD to power up
-	LCD_WriteCommand(0x38);
-	LCD_WriteCommand(0x06);
-	LCD_WriteCommand(0x0f);
-	LCD_WriteCommand(0x01);
-	delay_ms(10);
-}
-
-void LCD_WriteData(unsigned char Data) {
-	SET_BIT(CONTROL_BUS,RS);
-	transmit_data(Data); // added
-	//DATA_BUS = Data;
-	SET_BIT(CONTROL_BUS,E);
-	asm("nop");
-	CLR_BIT(CONTROL_BUS,E);
-	delay_ms(1);
-}
-
-void LCD_Cursor(unsigned char column) {
-	if ( column < 17 ) { // 16x2 LCD: column < 17; 16x1 LCD: column < 9
-		LCD_WriteCommand(0x80 + column - 1);
-		} else { // 6x2 LCD: column - 9; 16x1 LCD: column - 1
-		LCD_WriteCommand(0xB8 + column - 9);
-	}
-}
-
-void LCD_DisplayString( unsigned char column,  char* string) {
-	//LCD_ClearScreen();
-	unsigned char c = column;
-	while(*string) {
-		LCD_Cursor(c++);
-		LCD_WriteData(*string++);
-	}
-}
-
-void SLCD_WriteData(unsigned char column, unsigned char Data) {
-	LCD_Cursor(column);
-	LCD_WriteData(Data);
-}
-
-#endif // LCD_H
+// Permission to copy is granted provided that this header remains intact.
+// This software is provided with no warranties.
+
+#ifndef LCD_H
+#define LCD_H
+
+#include <stdio.h>
+#include <util/delay.h>
+
+#define SET_BIT(p,i) ((p) |= (1 << (i)))
+#define CLR_BIT(p,i) ((p) &= ~(1 << (i)))
+#define GET_BIT(p,i) ((p) & (1 << (i)))
+
+/*-------------------------------------------------------------------------*/
+
+// lcd.c speaks the HD44780 protocol and leaves moving bytes to the LCD to
+// one transport, picked at build time. Define LCD_TRANSPORT for the whole
+// build (-DLCD_TRANSPORT=...), not in a source file, so lcd.c and the
+// transport agree.
+// LCD_TRANSPORT_BITBANG: 74HC595 driven by bit-banging PORTD (lcd_595.c).
+// LCD_TRANSPORT_USART_SPI: the same 74HC595 clocked by USART1 in master SPI
+// mode (lcd_595.c).
+// LCD_TRANSPORT_PARALLEL4: LCD wired directly in 4 bit mode, with R/W
+// connected so the busy flag can be read instead of waiting (lcd_parallel.c).
+// LCD_TRANSPORT_PCF8574: I2C backpack on the DS3231 bus (lcd_pcf8574.c).
+#define LCD_TRANSPORT_BITBANG 0
+#define LCD_TRANSPORT_USART_SPI 1
+#define LCD_TRANSPORT_PARALLEL4 2
+#define LCD_TRANSPORT_PCF8574 3
+
+#ifndef LCD_TRANSPORT
+#define LCD_TRANSPORT LCD_TRANSPORT_BITBANG
+#endif
+
+// How long to wait after a write on transports that cannot read the busy
+// flag. Clear and home take 1.52ms, everything else 37us.
+#ifndef LCD_SLOW_MS
+#define LCD_SLOW_MS 2
+#endif
+
+#ifndef LCD_FAST_US
+#define LCD_FAST_US 50
+#endif
+
+/*-------------------------------------------------------------------------*/
+
+void delay_ms(int miliSec);
+
+void LCD_init(void);
+void LCD_WriteCommand(unsigned char Command);
+void LCD_WriteData(unsigned char Data);
+void LCD_ClearScreen(void);
+void LCD_Cursor(unsigned char column);
+void LCD_DisplayString(unsigned char column, char* string);
+void LCD_DisplayString_P(unsigned char column, const char* string); // string in PROGMEM
+void SLCD_WriteData(unsigned char column, unsigned char Data);
+
+// Custom characters. glyph is 8 rows in PROGMEM, low 5 bits of each used,
+// and shows up as character code slot (0-7). A slot is only uploaded when
+// it does not already hold that glyph. Afterwards writes go to CGRAM until
+// LCD_Cursor is called.
+void LCD_LoadGlyph_P(unsigned char slot, const unsigned char* glyph);
+
+#endif // LCD_H
@@ -0,0 +1,100 @@
+// Permission to copy is granted provided that this header remains intact.
+// This software is provided with no warranties.
+
+// 74HC595 transports - the shift register drives the LCD data bus, RS and E
+// are driven directly.
+// LCD_TRANSPORT_BITBANG: SER = PD3, SRCLK = PD1, RCLK = PD2, SRCLR = PD0.
+// LCD_TRANSPORT_USART_SPI: USART1 in master SPI mode clocks the byte out,
+// SER = PD3 (TXD1), SRCLK = PD4 (XCK1), RCLK = PD2, SRCLR = PD0.
+// The SRCLK wire has to move from PD1 to PD4 for the USART build.
+
+#include <avr/io.h>
+#include "lcd_transport.h"
+
+#if (LCD_TRANSPORT == LCD_TRANSPORT_BITBANG) || (LCD_TRANSPORT == LCD_TRANSPORT_USART_SPI)
+
+//#define DATA_BUS PORTD		// port connected to pins 7-14 of LCD display
+#define CONTROL_BUS PORTD	// port connected to pins 4 and 6 of LCD disp.
+#define RS 6			// pin number of uC connected to pin 4 of LCD disp.
+#define E 5				// pin number of uC connected to pin 6 of LCD disp.
+
+/*-------------------------------------------------------------------------*/
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_USART_SPI
+
+static void transmit_init(void) {
+	UBRR1 = 0; // must be zero when the transmitter is enabled
+	DDRD |= 0x1D; // XCK1 must be an output before the USART is set to master SPI mode
+	PORTD |= 0x01; // SRCLR stays high, the USART never clears the shift register
+	UCSR1C = (1 << UMSEL11) | (1 << UMSEL10); // master SPI, mode 0, MSB first
+	UCSR1B = (1 << TXEN1);
+	UBRR1 = 0; // fosc / 2, a byte takes 16 cpu cycles
+}
+
+// Starts shifting data out and returns straight away. UDR1 is double
+// buffered so this only waits if the previous byte has not moved on yet.
+static void transmit_data(unsigned char data) {
+	while(!(UCSR1A & (1 << UDRE1)));
+	UCSR1A = (1 << TXC1); // writing a one clears TXC1 for transmit_latch
+	UDR1 = data;
+}
+
+// Waits for the last byte to leave the shift register then copies it to
+// the 595 outputs. Called just before E is pulsed so the shift overlaps
+// with whatever the caller does in between.
+static void transmit_latch(void) {
+	while(!(UCSR1A & (1 << TXC1)));
+	PORTD |= 0x04; // RCLK rising edge
+	PORTD &= 0xFB;
+}
+
+#else
+
+static void transmit_init(void) {
+}
+
+static void transmit_data(unsigned char data) {
+	/* for each bit of data */
+	for(unsigned i = 0; i < 8; i++) {
+		PORTD |= 0x01; // Set SRCLR to 1 allowing data to be set
+		PORTD &= 0xFD; // Also clear SRCLK in preparation of sending data
+		if(data & 0x80) {
+			PORTD |= 0x08;
+		}
+		else {
+			PORTD &= 0xF7;
+		}// set SER = next bit of data to be sent.
+		PORTD |= 0x02; // set SRCLK = 1. Rising edge shifts next bit of data into the shift register
+		data = data << 1;
+	}
+	/* end for each bit of data */
+	PORTD |= 0x04; // set RCLK = 1. Rising edge copies data from the "Shift" register to the "Storage" register
+	PORTD &= 0xE0;  // clears all lines in preparation of a new transmission
+}
+
+static void transmit_latch(void) { // transmit_data already latched
+}
+
+#endif
+
+/*-------------------------------------------------------------------------*/
+
+void lcd_bus_init(void) {
+	transmit_init();
+}
+
+void lcd_bus_write(unsigned char rs, unsigned char value) {
+	transmit_data(value);
+	if(rs) {
+		SET_BIT(CONTROL_BUS,RS);
+	}
+	else {
+		CLR_BIT(CONTROL_BUS,RS);
+	}
+	transmit_latch();
+	SET_BIT(CONTROL_BUS,E);
+	asm("nop");
+	CLR_BIT(CONTROL_BUS,E);
+}
+
+#endif // LCD_TRANSPORT
@@ -0,0 +1,77 @@
+// Permission to copy is granted provided that this header remains intact.
+// This software is provided with no warranties.
+
+// LCD wired directly in 4 bit mode. D4-D7 go to the low four bits of
+// LCD_PAR_PORT, E, RS and R/W to the pins below. With R/W connected the
+// busy flag is read back, so the core never waits longer than it has to.
+
+#include <avr/io.h>
+#include "lcd_transport.h"
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_PARALLEL4
+
+#ifndef LCD_PAR_PORT
+#define LCD_PAR_PORT PORTD
+#define LCD_PAR_PIN PIND
+#define LCD_PAR_DDR DDRD
+#endif
+
+#define LCD_PAR_DATA 0x0F	// D4-D7
+#define LCD_PAR_E 5
+#define LCD_PAR_RS 6
+#define LCD_PAR_RW 7
+
+/*-------------------------------------------------------------------------*/
+
+static void lcd_par_strobe(void) {
+	SET_BIT(LCD_PAR_PORT,LCD_PAR_E);
+	_delay_us(1); // E high for at least 450ns
+	CLR_BIT(LCD_PAR_PORT,LCD_PAR_E);
+}
+
+static void lcd_par_nibble(unsigned char nibble) {
+	LCD_PAR_PORT = (LCD_PAR_PORT & ~LCD_PAR_DATA) | (nibble & LCD_PAR_DATA);
+	lcd_par_strobe();
+}
+
+void lcd_bus_init(void) {
+	LCD_PAR_DDR |= LCD_PAR_DATA | (1 << LCD_PAR_E) | (1 << LCD_PAR_RS) | (1 << LCD_PAR_RW);
+	LCD_PAR_PORT &= ~(LCD_PAR_DATA | (1 << LCD_PAR_E) | (1 << LCD_PAR_RS) | (1 << LCD_PAR_RW));
+}
+
+void lcd_bus_write(unsigned char rs, unsigned char value) {
+	if(rs) {
+		SET_BIT(LCD_PAR_PORT,LCD_PAR_RS);
+	}
+	else {
+		CLR_BIT(LCD_PAR_PORT,LCD_PAR_RS);
+	}
+	lcd_par_nibble(value >> 4);
+	lcd_par_nibble(value);
+}
+
+void lcd_bus_write_nibble(unsigned char nibble) {
+	CLR_BIT(LCD_PAR_PORT,LCD_PAR_RS);
+	lcd_par_nibble(nibble);
+}
+
+unsigned char lcd_bus_read_busy(void) {
+	unsigned char busy;
+
+	LCD_PAR_DDR &= ~LCD_PAR_DATA; // data lines to inputs, no pull-ups
+	LCD_PAR_PORT &= ~LCD_PAR_DATA;
+	CLR_BIT(LCD_PAR_PORT,LCD_PAR_RS);
+	SET_BIT(LCD_PAR_PORT,LCD_PAR_RW);
+
+	SET_BIT(LCD_PAR_PORT,LCD_PAR_E);
+	_delay_us(1); // data valid 360ns after E rises
+	busy = LCD_PAR_PIN & 0x08; // BF is D7, read with the high nibble
+	CLR_BIT(LCD_PAR_PORT,LCD_PAR_E);
+	lcd_par_strobe(); // low nibble (address counter) is not needed but has to be clocked out
+
+	CLR_BIT(LCD_PAR_PORT,LCD_PAR_RW);
+	LCD_PAR_DDR |= LCD_PAR_DATA;
+	return busy;
+}
+
+#endif // LCD_TRANSPORT
@@ -0,0 +1,55 @@
+// Permission to copy is granted provided that this header remains intact.
+// This software is provided with no warranties.
+
+// PCF8574 I2C backpack, using the usual wiring: P0 = RS, P1 = R/W, P2 = E,
+// P3 = backlight, P4-P7 = D4-D7. It shares the bus with the DS3231, so every
+// write goes through the bus task, at a lower priority than the clock.
+
+#include <stdint.h>
+#include <avr/io.h>
+#include "lcd_transport.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "i2cbus.h"
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_PCF8574
+
+#ifndef LCD_PCF_ADDRESS
+#define LCD_PCF_ADDRESS 0x4E	// 0x27 with the write bit, all address jumpers open
+#endif
+
+#define LCD_PCF_RS 0x01
+#define LCD_PCF_E 0x04
+#define LCD_PCF_BACKLIGHT 0x08
+
+/*-------------------------------------------------------------------------*/
+
+void lcd_bus_init(void) {
+	uint8_t idle = LCD_PCF_BACKLIGHT;
+
+	i2cbus_send(LCD_PCF_ADDRESS, &idle, 1, I2CBUS_PRIO_LCD); // i2cbus_start has already run
+}
+
+// A byte goes out as four port writes in one transaction: each nibble with
+// E high then low. At 100kHz every port write takes 90us, which covers the
+// E pulse width and the 37us a normal instruction takes.
+void lcd_bus_write(unsigned char rs, unsigned char value) {
+	uint8_t ctrl = LCD_PCF_BACKLIGHT | (rs ? LCD_PCF_RS : 0);
+	uint8_t frame[4];
+
+	frame[0] = (value & 0xF0) | ctrl | LCD_PCF_E;
+	frame[1] = (value & 0xF0) | ctrl;
+	frame[2] = (value << 4) | ctrl | LCD_PCF_E;
+	frame[3] = (value << 4) | ctrl;
+	i2cbus_send(LCD_PCF_ADDRESS, frame, 4, I2CBUS_PRIO_LCD);
+}
+
+void lcd_bus_write_nibble(unsigned char nibble) {
+	uint8_t frame[2];
+
+	frame[0] = (nibble << 4) | LCD_PCF_BACKLIGHT | LCD_PCF_E;
+	frame[1] = (nibble << 4) | LCD_PCF_BACKLIGHT;
+	i2cbus_send(LCD_PCF_ADDRESS, frame, 2, I2CBUS_PRIO_LCD);
+}
+
+#endif // LCD_TRANSPORT
@@ -0,0 +1,36 @@
+// Interface between the HD44780 core in lcd.c and the LCD transports.
+// Only lcd.c and the transport files include this.
+
+#ifndef LCD_TRANSPORT_H
+#define LCD_TRANSPORT_H
+
+#include "lcd.h"
+
+// LCD_BUS_4BIT: the transport carries a nibble at a time, a byte is sent
+// high nibble first and lcd_bus_write_nibble() is used during LCD_init().
+// LCD_BUS_READS_BUSY: lcd_bus_read_busy() is available and the core polls
+// it instead of waiting a fixed time.
+#if (LCD_TRANSPORT == LCD_TRANSPORT_PARALLEL4) || (LCD_TRANSPORT == LCD_TRANSPORT_PCF8574)
+#define LCD_BUS_4BIT 1
+#else
+#define LCD_BUS_4BIT 0
+#endif
+
+#if (LCD_TRANSPORT == LCD_TRANSPORT_PARALLEL4)
+#define LCD_BUS_READS_BUSY 1
+#else
+#define LCD_BUS_READS_BUSY 0
+#endif
+
+void lcd_bus_init(void); // set up pins and peripherals, the LCD has not powered up yet
+void lcd_bus_write(unsigned char rs, unsigned char value); // write a byte and strobe E, rs = 0 command, 1 data
+
+#if LCD_BUS_4BIT
+void lcd_bus_write_nibble(unsigned char nibble); // write the low nibble as a command, only used by LCD_init
+#endif
+
+#if LCD_BUS_READS_BUSY
+unsigned char lcd_bus_read_busy(void); // nonzero while the controller is busy
+#endif
+
+#endif // LCD_TRANSPORT_H
@@ -0,0 +1,65 @@
+/*
+ * Zero copy access to queues, implemented in queue.c.
+ *
+ * A producer acquires the next free slot, fills it in place and commits it.
+ * A consumer borrows the oldest item, uses it in place and releases it.  No
+ * item is ever copied, which matters for large items such as display frames.
+ *
+ * Any queue created with xQueueCreate() or xQueueCreateInPool() can be used
+ * this way, but the slot functions assume one producer and one consumer:
+ *   - between pvQueueAcquireSlot() and vQueueCommitSlot() nothing else may
+ *     write to the queue;
+ *   - between pvQueueBorrowSlot() and vQueueReleaseSlot() nothing else may
+ *     read from the queue, and xQueueOverwrite() must not be used.
+ *
+ * xQueueOverwrite() is for length 1 queues that hold a "latest value", such
+ * as the current time.  It always succeeds and replaces any unread value.
+ *
+ * FreeRTOS.h must be included before this file, and queue.h before it if the
+ * prototypes are wanted.
+ */
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#ifndef configUSE_QUEUE_MAILBOX
+	#define configUSE_QUEUE_MAILBOX 1
+#endif
+
+#if defined( QUEUE_H ) && ( configUSE_QUEUE_MAILBOX == 1 )
+
+	/*
+	 * Returns a pointer to the next free slot, waiting up to xTicksToWait for
+	 * one to become free.  Returns NULL if the queue stayed full.  The item
+	 * does not become visible to receivers until vQueueCommitSlot() is called.
+	 */
+	void *pvQueueAcquireSlot( xQueueHandle xQueue, portTickType xTicksToWait );
+
+	/*
+	 * Publishes the slot returned by pvQueueAcquireSlot(), waking a task
+	 * waiting to receive if there is one.
+	 */
+	void vQueueCommitSlot( xQueueHandle xQueue );
+
+	/*
+	 * Returns a pointer to the oldest item, waiting up to xTicksToWait for one
+	 * to arrive.  Returns NULL if the queue stayed empty.  The item stays in
+	 * the queue, and its slot cannot be reused, until vQueueReleaseSlot().
+	 */
+	const void *pvQueueBorrowSlot( xQueueHandle xQueue, portTickType xTicksToWait );
+
+	/*
+	 * Removes the item returned by pvQueueBorrowSlot(), waking a task waiting
+	 * to send if there is one.
+	 */
+	void vQueueReleaseSlot( xQueueHandle xQueue );
+
+	/*
+	 * Write to a length 1 queue, replacing the value already there if it is
+	 * full.  Always returns pdPASS.
+	 */
+	signed portBASE_TYPE xQueueOverwrite( xQueueHandle xQueue, const void * const pvItemToQueue );
+	signed portBASE_TYPE xQueueOverwriteFromISR( xQueueHandle xQueue, const void * const pvItemToQueue, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+#endif
+
+#endif /* MAILBOX_H */
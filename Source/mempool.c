@@ -0,0 +1,279 @@
+/*
+ * Fixed size block pools - see mempool.h.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mempool.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_MEMORY_POOLS == 1 )
+
+/*
+ * Pop / push the head of the free list.  Must be called with interrupts
+ * masked.
+ */
+static void *prvPoolTake( xMemoryPool *pxPool );
+static void prvPoolGive( xMemoryPool *pxPool, void *pv );
+
+#if ( configMEMPOOL_DEBUG == 1 )
+
+	/*
+	 * Fill / check everything in a free block other than its link.
+	 */
+	static void prvPoisonBlock( const xMemoryPool *pxPool, void *pv );
+	static void prvCheckPoison( const xMemoryPool *pxPool, void *pv );
+
+	/*
+	 * Assert that pv is the start of a block in the pool that is not already
+	 * on the free list.
+	 */
+	static void prvCheckOwnership( const xMemoryPool *pxPool, void *pv );
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+void vMemPoolInitialise( xMemoryPool *pxPool, void *pvStorage, size_t xBlockSize, size_t xBlockCount )
+{
+unsigned char *pucBlock;
+size_t x;
+
+	configASSERT( pxPool );
+	configASSERT( pvStorage );
+	configASSERT( xBlockSize >= sizeof( void * ) );
+
+	pxPool->xBlockSize = xBlockSize;
+	pxPool->xBlockCount = xBlockCount;
+	pxPool->xBlocksFree = xBlockCount;
+	pxPool->xMinimumBlocksFree = xBlockCount;
+	pxPool->uxFailedAllocations = ( unsigned portBASE_TYPE ) 0U;
+	pxPool->pvFreeList = NULL;
+
+	#if ( configMEMPOOL_DEBUG == 1 )
+	{
+		pxPool->pucStorage = ( unsigned char * ) pvStorage;
+	}
+	#endif
+
+	/* Link the blocks from the last to the first so that blocks are handed
+	out in address order. */
+	pucBlock = ( unsigned char * ) pvStorage + ( xBlockCount * xBlockSize );
+
+	for( x = 0; x < xBlockCount; x++ )
+	{
+		pucBlock -= xBlockSize;
+		*( ( void ** ) pucBlock ) = pxPool->pvFreeList;
+		pxPool->pvFreeList = ( void * ) pucBlock;
+
+		#if ( configMEMPOOL_DEBUG == 1 )
+		{
+			prvPoisonBlock( pxPool, pucBlock );
+		}
+		#endif
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void *prvPoolTake( xMemoryPool *pxPool )
+{
+void *pvReturn;
+
+	pvReturn = pxPool->pvFreeList;
+
+	if( pvReturn != NULL )
+	{
+		pxPool->pvFreeList = *( ( void ** ) pvReturn );
+		pxPool->xBlocksFree--;
+
+		if( pxPool->xBlocksFree < pxPool->xMinimumBlocksFree )
+		{
+			pxPool->xMinimumBlocksFree = pxPool->xBlocksFree;
+		}
+	}
+	else
+	{
+		pxPool->uxFailedAllocations++;
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPoolGive( xMemoryPool *pxPool, void *pv )
+{
+	*( ( void ** ) pv ) = pxPool->pvFreeList;
+	pxPool->pvFreeList = pv;
+	pxPool->xBlocksFree++;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMemPoolAlloc( xMemoryPool *pxPool )
+{
+void *pvReturn;
+
+	configASSERT( pxPool );
+
+	taskENTER_CRITICAL();
+	{
+		pvReturn = prvPoolTake( pxPool );
+	}
+	taskEXIT_CRITICAL();
+
+	/* The block now belongs to the caller so can be checked outside of the
+	critical section. */
+	#if ( configMEMPOOL_DEBUG == 1 )
+	{
+		if( pvReturn != NULL )
+		{
+			prvCheckPoison( pxPool, pvReturn );
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMemPoolAllocFromISR( xMemoryPool *pxPool )
+{
+void *pvReturn;
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxPool );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pvReturn = prvPoolTake( pxPool );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	#if ( configMEMPOOL_DEBUG == 1 )
+	{
+		if( pvReturn != NULL )
+		{
+			prvCheckPoison( pxPool, pvReturn );
+		}
+	}
+	#endif
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFree( xMemoryPool *pxPool, void *pv )
+{
+	configASSERT( pxPool );
+	configASSERT( pv );
+
+	taskENTER_CRITICAL();
+	{
+		#if ( configMEMPOOL_DEBUG == 1 )
+		{
+			/* Checked inside the critical section as it walks the free
+			list. */
+			prvCheckOwnership( pxPool, pv );
+			prvPoisonBlock( pxPool, pv );
+		}
+		#endif
+
+		prvPoolGive( pxPool, pv );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFreeFromISR( xMemoryPool *pxPool, void *pv )
+{
+unsigned portBASE_TYPE uxSavedInterruptStatus;
+
+	configASSERT( pxPool );
+	configASSERT( pv );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		#if ( configMEMPOOL_DEBUG == 1 )
+		{
+			prvCheckOwnership( pxPool, pv );
+			prvPoisonBlock( pxPool, pv );
+		}
+		#endif
+
+		prvPoolGive( pxPool, pv );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+size_t xMemPoolGetHighWaterMark( const xMemoryPool *pxPool )
+{
+size_t xMinimum;
+
+	/* Not a single byte on 8 bit ports, so read it where an allocation from
+	an ISR can not change it half way. */
+	taskENTER_CRITICAL();
+	{
+		xMinimum = pxPool->xMinimumBlocksFree;
+	}
+	taskEXIT_CRITICAL();
+
+	return pxPool->xBlockCount - xMinimum;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configMEMPOOL_DEBUG == 1 )
+
+	static void prvPoisonBlock( const xMemoryPool *pxPool, void *pv )
+	{
+		memset( ( unsigned char * ) pv + sizeof( void * ), memPOOL_POISON_BYTE, pxPool->xBlockSize - sizeof( void * ) );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCheckPoison( const xMemoryPool *pxPool, void *pv )
+	{
+	const unsigned char *pucByte;
+	size_t x;
+
+		pucByte = ( const unsigned char * ) pv + sizeof( void * );
+
+		for( x = sizeof( void * ); x < pxPool->xBlockSize; x++ )
+		{
+			/* Something wrote to the block while it was free. */
+			configASSERT( *pucByte == memPOOL_POISON_BYTE );
+			pucByte++;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCheckOwnership( const xMemoryPool *pxPool, void *pv )
+	{
+	const unsigned char *pucBlock = ( const unsigned char * ) pv;
+	size_t xOffset;
+	void *pvFree;
+
+		configASSERT( pucBlock >= pxPool->pucStorage );
+
+		xOffset = ( size_t ) ( pucBlock - pxPool->pucStorage );
+		configASSERT( xOffset < ( pxPool->xBlockCount * pxPool->xBlockSize ) );
+		configASSERT( ( xOffset % pxPool->xBlockSize ) == 0U );
+
+		for( pvFree = pxPool->pvFreeList; pvFree != NULL; pvFree = *( ( void ** ) pvFree ) )
+		{
+			/* Freed twice. */
+			configASSERT( pvFree != pv );
+		}
+
+		( void ) xOffset;
+	}
+
+#endif /* configMEMPOOL_DEBUG */
+
+#endif /* configUSE_MEMORY_POOLS */
@@ -0,0 +1,95 @@
+/*
+ * Fixed size block pools.
+ *
+ * A pool hands out blocks of one size from storage supplied by the caller,
+ * so allocating and freeing is a pointer pop/push inside a short critical
+ * section instead of a pvPortMalloc() call with the scheduler suspended.
+ * Pools can be used from tasks and, through the FromISR variants, from
+ * interrupts.  xQueueCreateInPool() (queue.c) takes its storage area from a
+ * pool.
+ *
+ * FreeRTOS.h must be included before this file.
+ */
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+
+#ifndef configUSE_MEMORY_POOLS
+	#define configUSE_MEMORY_POOLS 1
+#endif
+
+/* When 1, free blocks are filled with memPOOL_POISON_BYTE and checked again
+when they are handed out, catching writes through stale pointers.  Double
+frees and pointers that do not belong to the pool are caught as well. */
+#ifndef configMEMPOOL_DEBUG
+	#define configMEMPOOL_DEBUG 0
+#endif
+
+#define memPOOL_POISON_BYTE		( ( unsigned char ) 0xdd )
+
+typedef struct xMEMORY_POOL
+{
+	void *pvFreeList;							/*< First free block.  Each free block starts with a pointer to the next one. */
+	size_t xBlockSize;							/*< Size of each block in bytes, at least sizeof( void * ). */
+	size_t xBlockCount;							/*< Number of blocks in the pool.  Sizes and counts are not portBASE_TYPE, which is 8 bits on some ports. */
+	volatile size_t xBlocksFree;
+	size_t xMinimumBlocksFree;					/*< Lowest value of xBlocksFree seen so far. */
+	unsigned portBASE_TYPE uxFailedAllocations;
+
+	#if ( configMEMPOOL_DEBUG == 1 )
+		unsigned char *pucStorage;				/*< Start of the storage, used to validate freed pointers. */
+	#endif
+} xMemoryPool;
+
+/*
+ * Declares storage for uxCount objects of type xType, padded where necessary
+ * so each block can hold the free list link.  For example:
+ *
+ *	memPOOL_STORAGE( xEventStorage, xUIEvent, 8 );
+ *	static xMemoryPool xEventPool;
+ *	...
+ *	memPOOL_INITIALISE( &xEventPool, xEventStorage );
+ *	xUIEvent *pxEvent = memPOOL_ALLOC( &xEventPool, xUIEvent );
+ */
+#define memPOOL_STORAGE( xName, xType, uxCount )	\
+	static union { xType xItem; void *pvLink; } xName[ ( uxCount ) ]
+
+#define memPOOL_INITIALISE( pxPool, xStorage )		\
+	vMemPoolInitialise( ( pxPool ), ( xStorage ), sizeof( ( xStorage )[ 0 ] ), sizeof( xStorage ) / sizeof( ( xStorage )[ 0 ] ) )
+
+#define memPOOL_ALLOC( pxPool, xType )				( ( xType * ) pvMemPoolAlloc( pxPool ) )
+#define memPOOL_ALLOC_FROM_ISR( pxPool, xType )		( ( xType * ) pvMemPoolAllocFromISR( pxPool ) )
+
+/*
+ * Links xBlockCount blocks of xBlockSize bytes from pvStorage into the free
+ * list of pxPool.  xBlockSize must be at least sizeof( void * ).
+ */
+void vMemPoolInitialise( xMemoryPool *pxPool, void *pvStorage, size_t xBlockSize, size_t xBlockCount );
+
+/*
+ * Take a block from the pool.  Returns NULL if the pool is empty - these
+ * calls never block.
+ */
+void *pvMemPoolAlloc( xMemoryPool *pxPool );
+void *pvMemPoolAllocFromISR( xMemoryPool *pxPool );
+
+/*
+ * Return a block obtained from the same pool.
+ */
+void vMemPoolFree( xMemoryPool *pxPool, void *pv );
+void vMemPoolFreeFromISR( xMemoryPool *pxPool, void *pv );
+
+/*
+ * Largest number of blocks that have been in use at the same time.
+ */
+size_t xMemPoolGetHighWaterMark( const xMemoryPool *pxPool );
+
+/*
+ * Implemented in queue.c.  Creates a queue whose storage area is one block of
+ * pxPool, which must be at least ( uxQueueLength * uxItemSize ) + 1 bytes.
+ * vQueueDelete() gives the block back to the pool.
+ */
+#if defined( QUEUE_H ) && ( configUSE_MEMORY_POOLS == 1 )
+	xQueueHandle xQueueCreateInPool( xMemoryPool *pxPool, unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize );
+#endif
+
+#endif /* MEMPOOL_H */
@@ -0,0 +1,46 @@
+#include <avr/pgmspace.h>
+#include "numfmt.h"
+
+/* AVR has no divide instruction, so / 10 and % 10 are a libgcc loop each.
+Everything here uses shifts, the 8x8 multiplier or a table instead. */
+
+#define NUM_ROW(t) {t,'0'},{t,'1'},{t,'2'},{t,'3'},{t,'4'},{t,'5'},{t,'6'},{t,'7'},{t,'8'},{t,'9'}
+
+/* "00" to "99" */
+const char num_digits[100][2] PROGMEM = {
+	NUM_ROW('0'), NUM_ROW('1'), NUM_ROW('2'), NUM_ROW('3'), NUM_ROW('4'),
+	NUM_ROW('5'), NUM_ROW('6'), NUM_ROW('7'), NUM_ROW('8'), NUM_ROW('9')
+};
+
+uint8_t num_bcd2dec(uint8_t b)
+{
+	uint8_t t = b >> 4;
+	return (t << 3) + (t << 1) + (b & 0x0F); // tens * 10 + ones
+}
+
+uint8_t num_dec2bcd(uint8_t d)
+{
+	uint8_t t = ((uint16_t)d * 205) >> 11; // d / 10, exact for d < 180
+	return (t << 4) | (d - ((t << 3) + (t << 1)));
+}
+
+uint8_t num_c2f(uint8_t c)
+{
+	uint16_t x = (uint16_t)c * 9;
+	return ((x * 205UL) >> 10) + 32; // x / 5, exact for x < 1024
+}
+
+void num_put_bcd(char *out, uint8_t bcd)
+{
+	out[0] = NUM_BCD_TENS(bcd);
+	out[1] = NUM_BCD_ONES(bcd);
+}
+
+void num_put_dec(char *out, uint8_t dec)
+{
+	if(dec > 99) {
+		dec = 99;
+	}
+	out[0] = pgm_read_byte(&num_digits[dec][0]);
+	out[1] = pgm_read_byte(&num_digits[dec][1]);
+}
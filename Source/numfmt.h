@@ -0,0 +1,18 @@
+/* Division free number formatting for the display */
+#ifndef NUMFMT_H
+#define NUMFMT_H
+
+#include <stdint.h>
+
+/* ASCII digits of a packed BCD byte, as the DS3231 returns them */
+#define NUM_BCD_TENS(b) ('0' + ((b) >> 4))
+#define NUM_BCD_ONES(b) ('0' + ((b) & 0x0F))
+
+uint8_t num_bcd2dec(uint8_t b);
+uint8_t num_dec2bcd(uint8_t d); // d < 100
+uint8_t num_c2f(uint8_t c); // whole degrees C to F, c < 100
+
+void num_put_bcd(char *out, uint8_t bcd); // two digits, not terminated
+void num_put_dec(char *out, uint8_t dec); // two digits, not terminated, 99 and up shows 99
+
+#endif
@@ -0,0 +1,129 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/eeprom.h>
+#include <util/crc16.h>
+#include <stddef.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "settings.h"
+
+#define SETTINGS_ADDR(slot) (SETTINGS_BASE + (uint16_t)(slot) * sizeof(xSettings))
+#define SETTINGS_CRC_LEN (sizeof(xSettings) - sizeof(uint16_t))
+
+static xSettings settings_pending; // latest from settings_save
+static uint8_t settings_dirty = 0;
+static portTickType settings_changed; // tick of the last settings_save
+
+/* The write in progress. EE_READY_vect writes it one byte at a time while
+settings_busy is set, nothing else touches it then. */
+static xSettings settings_out;
+static uint16_t settings_addr;
+static uint8_t settings_pos;
+static volatile uint8_t settings_busy = 0;
+
+static uint8_t settings_slot = SETTINGS_SLOTS - 1; // slot of the newest record
+static uint8_t settings_seq = 0xFF;
+
+static uint16_t settings_crc(const xSettings *s) {
+	const uint8_t *p = (const uint8_t *)s;
+	uint16_t crc = 0xFFFF;
+	uint8_t i;
+	for(i = 0; i < SETTINGS_CRC_LEN; i++) {
+		crc = _crc_ccitt_update(crc, p[i]);
+	}
+	return crc;
+}
+
+/* Only the version and seq bytes of each slot are read to find the newest
+record, then only that one is read in full and checked. If its CRC is bad
+(power went in the middle of a write) the one before it is tried. About 70
+EEPROM reads and one CRC of 36 bytes, a few hundred microseconds. */
+uint8_t settings_load(xSettings *s) {
+	uint8_t seq[SETTINGS_SLOTS];
+	uint8_t valid[SETTINGS_SLOTS];
+	uint8_t i, best, tries;
+	xSettings r; // s is only written once a record checks out
+
+	for(i = 0; i < SETTINGS_SLOTS; i++) {
+		valid[i] = eeprom_read_byte((const uint8_t *)(SETTINGS_ADDR(i) + offsetof(xSettings, version))) == SETTINGS_VERSION;
+		seq[i] = eeprom_read_byte((const uint8_t *)(SETTINGS_ADDR(i) + offsetof(xSettings, seq)));
+	}
+
+	for(tries = 0; tries < SETTINGS_SLOTS; tries++) {
+		best = 0xFF;
+		for(i = 0; i < SETTINGS_SLOTS; i++) {
+			if(valid[i] && (best == 0xFF || (int8_t)(seq[i] - seq[best]) > 0)) {
+				best = i;
+			}
+		}
+		if(best == 0xFF) {
+			return 0; // blank or nothing good, the next save starts at slot 0
+		}
+		eeprom_read_block(&r, (const void *)SETTINGS_ADDR(best), sizeof(xSettings));
+		if(r.version == SETTINGS_VERSION && r.crc == settings_crc(&r)) {
+			memcpy(s, &r, sizeof(xSettings));
+			settings_slot = best;
+			settings_seq = r.seq;
+			return 1;
+		}
+		valid[best] = 0;
+	}
+	return 0;
+}
+
+void settings_save(const xSettings *s) {
+	taskENTER_CRITICAL();
+	memcpy(&settings_pending, s, sizeof(xSettings));
+	settings_dirty = 1;
+	settings_changed = xTaskGetTickCount();
+	taskEXIT_CRITICAL();
+}
+
+void settings_idle(void) {
+	if(!settings_dirty || settings_busy) {
+		return;
+	}
+	if((portTickType)(xTaskGetTickCount() - settings_changed) < SETTINGS_QUIET_MS / portTICK_RATE_MS) {
+		return;
+	}
+
+	taskENTER_CRITICAL();
+	memcpy(&settings_out, &settings_pending, sizeof(xSettings));
+	settings_dirty = 0;
+	taskEXIT_CRITICAL();
+
+	if(++settings_slot >= SETTINGS_SLOTS) {
+		settings_slot = 0;
+	}
+	settings_out.version = SETTINGS_VERSION;
+	settings_out.seq = ++settings_seq;
+	settings_out.crc = settings_crc(&settings_out);
+	settings_addr = SETTINGS_ADDR(settings_slot);
+	settings_pos = 0;
+	settings_busy = 1;
+	EECR |= (1 << EERIE); // EE_READY_vect fires at once, the EEPROM is idle
+}
+
+/* Fires whenever the EEPROM is ready while EERIE is set. Bytes that already
+hold the right value are skipped, each one that differs starts a 3.3ms
+erase and write and returns, so no task ever waits on the EEPROM. */
+ISR(EE_READY_vect) {
+	const uint8_t *p = (const uint8_t *)&settings_out;
+	uint8_t b;
+
+	while(settings_pos < sizeof(xSettings)) {
+		b = p[settings_pos];
+		EEAR = settings_addr + settings_pos;
+		settings_pos++;
+		EECR |= (1 << EERE);
+		if(EEDR != b) {
+			EEDR = b;
+			EECR |= (1 << EEMPE);
+			EECR |= (1 << EEPE); // within 4 cycles of EEMPE, interrupts are already off
+			return;
+		}
+	}
+	EECR &= ~(1 << EERIE);
+	settings_busy = 0;
+}
@@ -0,0 +1,33 @@
+/* Settings kept in EEPROM. FreeRTOS.h must be included before this file. */
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <stdint.h>
+#include "alarms.h"
+
+#define SETTINGS_VERSION 1 // change when xSettings changes, older records are then ignored
+#define SETTINGS_BASE 0 // EEPROM address of the ring
+#define SETTINGS_SLOTS 16 // each save goes to the next slot, so a byte is rewritten once per 16 saves
+#define SETTINGS_QUIET_MS 3000 // a save waits until nothing has changed for this long
+
+typedef struct {
+	uint8_t hour;
+	uint8_t min;
+	uint8_t days;
+	uint8_t flags; // 0 for an empty slot
+} xAlarmRule;
+
+typedef struct {
+	uint8_t version;
+	uint8_t timeset;
+	uint8_t tempset;
+	xAlarmRule alarms[ALARM_MAX];
+	uint8_t seq; // one more than the record before it, wraps
+	uint16_t crc; // CRC-CCITT of everything above
+} xSettings;
+
+uint8_t settings_load(xSettings *s); // newest good record, 0 and s untouched if there is none
+void settings_save(const xSettings *s); // queue s, written once the settings stay unchanged for SETTINGS_QUIET_MS
+void settings_idle(void); // call from the idle hook, starts the queued write
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Direct to task notifications, implemented in tasks.c.
+ *
+ * Each task has a 32 bit notification value and a notification state in its
+ * TCB.  Notifying a task updates the value and, if the task is waiting for a
+ * notification, moves it straight back to the ready list.  This makes a
+ * cheaper alternative to a binary or counting semaphore (no queue object,
+ * no event lists, no queue locking) when exactly one task is the receiver.
+ *
+ * FreeRTOS.h and task.h must be included before this file.
+ */
+#ifndef TASK_NOTIFY_H
+#define TASK_NOTIFY_H
+
+#ifndef configUSE_TASK_NOTIFICATIONS
+	#define configUSE_TASK_NOTIFICATIONS 1
+#endif
+
+/* What a notification does to the receiving task's notification value. */
+typedef enum
+{
+	eNoAction = 0,				/* Notify the task without changing its value. */
+	eSetBits,					/* OR the value passed in into the task's value. */
+	eIncrement,					/* Add one to the task's value - used as a counting semaphore. */
+	eSetValueWithOverwrite,		/* Set the value, even if the task has not read the previous one. */
+	eSetValueWithoutOverwrite	/* Set the value only if the task has read the previous one. */
+} eNotifyAction;
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	/*
+	 * Send a notification to xTaskToNotify.  Returns pdFAIL only when eAction
+	 * is eSetValueWithoutOverwrite and the task still had an unread value.
+	 */
+	signed portBASE_TYPE xTaskGenericNotify( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction );
+
+	/*
+	 * As xTaskGenericNotify() but for use from an ISR.  *pxHigherPriorityTaskWoken
+	 * is set to pdTRUE if the notified task has a higher priority than the
+	 * interrupted task, in which case a context switch should be requested
+	 * before the ISR exits.
+	 */
+	signed portBASE_TYPE xTaskGenericNotifyFromISR( xTaskHandle xTaskToNotify, unsigned long ulValue, eNotifyAction eAction, signed portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+	/*
+	 * Wait up to xTicksToWait for a notification.  ulBitsToClearOnEntry are
+	 * cleared from the value before waiting (only if no notification is
+	 * already pending), ulBitsToClearOnExit after it is read.  The value is
+	 * written to *pulNotificationValue when that is not NULL.  Returns pdFALSE
+	 * on timeout.
+	 */
+	portBASE_TYPE xTaskNotifyWait( unsigned long ulBitsToClearOnEntry, unsigned long ulBitsToClearOnExit, unsigned long *pulNotificationValue, portTickType xTicksToWait );
+
+	/*
+	 * Semaphore style take.  Waits up to xTicksToWait for the value to be non
+	 * zero, then either decrements it (xClearCountOnExit == pdFALSE, counting
+	 * semaphore) or clears it (pdTRUE, binary semaphore).  Returns the value
+	 * before it was decremented or cleared, 0 on timeout.
+	 */
+	unsigned long ulTaskNotifyTake( portBASE_TYPE xClearCountOnExit, portTickType xTicksToWait );
+
+	#define xTaskNotify( xTaskToNotify, ulValue, eAction )	xTaskGenericNotify( ( xTaskToNotify ), ( ulValue ), ( eAction ) )
+	#define xTaskNotifySetBits( xTaskToNotify, ulBits )		xTaskGenericNotify( ( xTaskToNotify ), ( ulBits ), eSetBits )
+	#define xTaskNotifyGive( xTaskToNotify )				xTaskGenericNotify( ( xTaskToNotify ), 0UL, eIncrement )
+
+	#define xTaskNotifyFromISR( xTaskToNotify, ulValue, eAction, pxHigherPriorityTaskWoken )	\
+		xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulValue ), ( eAction ), ( pxHigherPriorityTaskWoken ) )
+	#define xTaskNotifySetBitsFromISR( xTaskToNotify, ulBits, pxHigherPriorityTaskWoken )		\
+		xTaskGenericNotifyFromISR( ( xTaskToNotify ), ( ulBits ), eSetBits, ( pxHigherPriorityTaskWoken ) )
+	#define vTaskNotifyGiveFromISR( xTaskToNotify, pxHigherPriorityTaskWoken )				\
+		( ( void ) xTaskGenericNotifyFromISR( ( xTaskToNotify ), 0UL, eIncrement, ( pxHigherPriorityTaskWoken ) ) )
+
+#endif
+
+#endif /* TASK_NOTIFY_H */
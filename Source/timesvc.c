@@ -0,0 +1,299 @@
+#include <string.h>
+#include <util/delay.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "task_notify.h"
+#include "i2cbus.h"
+#include "ds3231.h"
+#include "numfmt.h"
+#include "calendar.h"
+#include "tz.h"
+#include "timesvc.h"
+
+// notification bits, what other tasks want done
+#define TS_REQ_HOUR 0x01
+#define TS_REQ_A1 0x02
+#define TS_REQ_TEMP 0x04
+#define TS_REQ_FIRE 0x08
+
+/* Two snapshots. ts_buf[ts_gen & 1] is the published one, the service
+fills the other and then bumps ts_gen, a single byte store. A reader that
+was interrupted by a publish sees ts_gen change and copies again. The
+writer never waits on readers, so a reader can not hold it up whatever
+the priorities. */
+static xTime ts_buf[2];
+static volatile uint8_t ts_gen = 0;
+
+static xTaskHandle ts_task = NULL;
+
+// requests, filled in by the callers under a critical section
+static volatile uint8_t ts_temp_max = TIMESVC_TEMP_SECS; // a single byte, no lock needed
+static uint8_t ts_want_twelve = 0;
+static uint8_t ts_a1_on = 0;
+static uint8_t ts_a1_day, ts_a1_hour, ts_a1_min;
+
+// kept between polls by the service
+static uint8_t ts_twelve = 0; // display mode, the DS3231 itself stays in 24 hours
+static int16_t ts_offset = 0; // UTC offset of the last snapshot, minutes
+static uint8_t ts_last_sec = 0xFF;
+static uint8_t ts_a1_count = 0;
+static int16_t ts_utc_mow = 0; // minute of the UTC week of the last snapshot
+
+/* Reads the time and publishes a snapshot if the second moved on or force
+is set. Alarm 1 and the temperature are only looked at once per second.
+Returns how many minutes the UTC offset moved since the last snapshot,
+0 nearly always. */
+static int16_t ts_poll(uint8_t force) {
+	uint8_t h, m, s, yr, mnth, dt, day, utc_day, pm;
+	int16_t offset, shift;
+	xCalTime c;
+	xTime *t;
+	portTickType age;
+	uint32_t age_secs;
+
+	ds3231_get(&h, &m, &s, &yr, &mnth, &dt, &day);
+	if(s == ts_last_sec && !force) {
+		return 0;
+	}
+	ts_last_sec = s;
+
+	/* The registers hold UTC. Anything not a valid date is pulled back
+	into range so the calendar can not index past its tables. */
+	if(h & 0x40) { // left in 12 hour mode, timesvc_start normally fixes that
+		c.hour = cal_hour24(num_bcd2dec(h & 0x1F), (h & 0x20) ? 1 : 0);
+	}
+	else {
+		c.hour = num_bcd2dec(h & 0x3F);
+	}
+	c.sec = num_bcd2dec(s);
+	c.min = num_bcd2dec(m);
+	c.month = num_bcd2dec(mnth & 0x1F); // bit 7 is the century
+	if(c.month < 1 || c.month > 12) {
+		c.month = 1;
+	}
+	c.year = num_bcd2dec(yr);
+	c.date = num_bcd2dec(dt);
+	if(c.date < 1 || c.date > cal_month_len(c.year, c.month)) {
+		c.date = 1;
+	}
+
+	/* Alarm 1 matches on the DS3231's own day register, so that is put
+	right if it disagrees with the date. */
+	utc_day = cal_dow(c.year, c.month, c.date);
+	if(day != utc_day) {
+		ds3231_writeReg(0x03, utc_day);
+	}
+	ts_utc_mow = (int16_t)(utc_day - 1) * 1440 + (int16_t)c.hour * 60 + c.min;
+
+	t = &ts_buf[(ts_gen + 1) & 1]; // nobody reads this one
+	t->epoch = cal_to_epoch(&c);
+	cal_from_epoch(tz_local(t->epoch), &c);
+	offset = tz_offset();
+	t->utc_offset = offset;
+	t->dst = tz_dst();
+
+	t->sec = c.sec;
+	t->min = c.min;
+	t->hour = c.hour;
+	t->day = c.day;
+	t->date = c.date;
+	t->month = c.month;
+	t->year = c.year;
+	t->sec_bcd = num_dec2bcd(c.sec);
+	t->min_bcd = num_dec2bcd(c.min);
+	t->date_bcd = num_dec2bcd(c.date);
+	t->month_bcd = num_dec2bcd(c.month);
+	t->year_bcd = num_dec2bcd(c.year);
+	t->twelve = ts_twelve;
+	if(ts_twelve) {
+		t->hour_bcd = num_dec2bcd(cal_hour12(c.hour, &pm));
+		t->pm = pm;
+	}
+	else {
+		t->hour_bcd = num_dec2bcd(c.hour);
+		t->pm = 0;
+	}
+
+	if(ds3231_checkA1()) {
+		ts_a1_count++;
+	}
+	/* The temperature comes from the driver's cache. When it is older than
+	the consumers asked for a conversion is started, TimeTask picks up the
+	result on a later poll and the snapshot carries the old value till then. */
+	t->temp = ds3231_temp(&age);
+	if(age == DS3231_TEMP_OLD) {
+		t->temp_age = TIMESVC_TEMP_OLD;
+	}
+	else {
+		age_secs = (uint32_t)age * portTICK_RATE_MS / 1000;
+		t->temp_age = age_secs < TIMESVC_TEMP_OLD ? age_secs : TIMESVC_TEMP_OLD;
+	}
+	if(t->temp_age >= ts_temp_max) {
+		ds3231_conv_start(); // does nothing if one is running
+	}
+	t->a1_count = ts_a1_count;
+
+	ts_gen++; // publish
+
+	shift = offset - ts_offset;
+	ts_offset = offset;
+	return shift;
+}
+
+/* Alarms are asked for in local time, alarm 1 runs on UTC. The offset at
+the moment is used, and the alarm is programmed again whenever the offset
+changes, so a summer time change in between is followed. shift is how
+far the offset has just moved. */
+static void ts_program_a1(int16_t shift) {
+	uint8_t on, day, hour, min;
+	int16_t mow, behind;
+
+	taskENTER_CRITICAL();
+	on = ts_a1_on;
+	day = ts_a1_day;
+	hour = ts_a1_hour;
+	min = ts_a1_min;
+	taskEXIT_CRITICAL();
+
+	if(!on) {
+		ds3231_clearA1();
+		return;
+	}
+	mow = (int16_t)(day - 1) * 1440 + (int16_t)hour * 60 + min - ts_offset; // minute of the UTC week
+	while(mow < 0) {
+		mow += 10080;
+	}
+	while(mow >= 10080) {
+		mow -= 10080;
+	}
+	/* When the clocks go forward an alarm in the skipped hour, or right at
+	the change, ends up behind the time now and would only match again next
+	week, with every other alarm stuck behind it. Ring it now instead. */
+	if(shift > 0) {
+		behind = ts_utc_mow - mow;
+		if(behind < 0) {
+			behind += 10080;
+		}
+		if(behind < shift) {
+			ts_a1_count++; // in the snapshot from the next second on
+		}
+	}
+	day = 1;
+	while(mow >= 1440) {
+		mow -= 1440;
+		day++;
+	}
+	hour = (uint16_t)mow / 60;
+	min = (uint16_t)mow - (uint16_t)hour * 60;
+	ds3231_setA1(day, num_dec2bcd(hour), num_dec2bcd(min)); // the DS3231 is always in 24 hour mode
+}
+
+static void TimeTask(void *pvParameters) {
+	unsigned long req;
+	int16_t shift;
+
+	(void) pvParameters;
+
+	for(;;) {
+		req = 0;
+		xTaskNotifyWait(0, ~0UL, &req, TIMESVC_POLL_MS / portTICK_RATE_MS);
+		req &= ~I2CBUS_DONE_BIT; // a transfer's done bit is not a request
+
+		if(req & TS_REQ_HOUR) {
+			taskENTER_CRITICAL();
+			ts_twelve = ts_want_twelve;
+			taskEXIT_CRITICAL();
+		}
+		if(req & TS_REQ_FIRE) {
+			ts_a1_count++; // published by the forced poll below
+		}
+		if(ds3231_conv_poll()) {
+			req |= TS_REQ_TEMP; // publish the new temperature now, not at the next second
+		}
+		shift = ts_poll(req != 0);
+		if(shift) {
+			req |= TS_REQ_A1;
+		}
+		if(req & TS_REQ_A1) {
+			ts_program_a1(shift);
+		}
+	}
+}
+
+void timesvc_start(unsigned portBASE_TYPE Priority) {
+	uint8_t i;
+
+	tz_select(TZ_ZONE);
+	ds3231_setHr(0x01, ds3231_readReg(0x02)); // UTC is kept in 24 hour mode, the display does its own 12 hours
+	/* The only place that waits for a conversion, so the first snapshot has
+	a temperature. A conversion takes 200ms at most, give up after 300ms
+	and let TimeTask finish it. */
+	ds3231_conv_start();
+	for(i = 0; i < 30 && !ds3231_conv_poll(); i++) {
+		_delay_ms(10);
+	}
+	ts_poll(1); // there is a snapshot before anything asks, the scheduler is not running yet
+	xTaskCreate(TimeTask, (signed portCHAR *)"TimeTask", configMINIMAL_STACK_SIZE, NULL, Priority, &ts_task);
+}
+
+uint8_t timesvc_get(xTime *t) {
+	uint8_t gen;
+	do {
+		gen = ts_gen;
+		memcpy(t, &ts_buf[gen & 1], sizeof(xTime));
+	} while(gen != ts_gen);
+	return gen;
+}
+
+uint8_t timesvc_gen(void) {
+	return ts_gen;
+}
+
+int8_t timesvc_temp(uint8_t *age) {
+	xTime *t;
+	int8_t temp;
+	uint8_t gen;
+	do {
+		gen = ts_gen;
+		t = &ts_buf[gen & 1];
+		temp = t->temp;
+		*age = t->temp_age;
+	} while(gen != ts_gen);
+	return temp;
+}
+
+void timesvc_temp_max_age(uint8_t secs) {
+	ts_temp_max = secs;
+}
+
+uint8_t timesvc_a1_count(void) {
+	return ts_buf[ts_gen & 1].a1_count; // a single byte, no need to check the generation
+}
+
+void timesvc_set_hour_mode(uint8_t twelve) {
+	taskENTER_CRITICAL();
+	ts_want_twelve = twelve ? 1 : 0;
+	taskEXIT_CRITICAL();
+	xTaskNotifySetBits(ts_task, TS_REQ_HOUR);
+}
+
+void timesvc_set_a1(uint8_t day, uint8_t hour, uint8_t min) {
+	taskENTER_CRITICAL();
+	ts_a1_on = 1;
+	ts_a1_day = day;
+	ts_a1_hour = hour;
+	ts_a1_min = min;
+	taskEXIT_CRITICAL();
+	xTaskNotifySetBits(ts_task, TS_REQ_A1);
+}
+
+void timesvc_fire_a1(void) {
+	xTaskNotifySetBits(ts_task, TS_REQ_FIRE);
+}
+
+void timesvc_clear_a1(void) {
+	taskENTER_CRITICAL();
+	ts_a1_on = 0;
+	taskEXIT_CRITICAL();
+	xTaskNotifySetBits(ts_task, TS_REQ_A1);
+}
@@ -0,0 +1,54 @@
+/* Time service. One task owns the DS3231: it polls the time, programs
+alarm 1, and publishes what it read as an xTime snapshot. Other tasks copy
+the snapshot with timesvc_get, which takes no lock and does no I2C.
+The DS3231 keeps UTC in 24 hour mode. The snapshot is local time from the
+TZ_ZONE rules in tz.c, in the 12 or 24 hour form asked for.
+FreeRTOS.h must be included before this file. */
+#ifndef TIMESVC_H
+#define TIMESVC_H
+
+#include <stdint.h>
+
+#define TIMESVC_POLL_MS 100 // how often the time registers are read, a new second shows up within this
+#define TIMESVC_TEMP_SECS 64 // default for timesvc_temp_max_age, the DS3231 converts this often by itself anyway
+#define TIMESVC_TEMP_OLD 255 // temp_age when it is not known
+
+typedef struct {
+	// local time, BCD for the display
+	uint8_t sec_bcd;
+	uint8_t min_bcd;
+	uint8_t hour_bcd; // hour digits in the clock's mode, 1-12 or 0-23
+	uint8_t date_bcd;
+	uint8_t month_bcd;
+	uint8_t year_bcd;
+	uint8_t twelve; // 1 when hour_bcd is 1-12
+	uint8_t pm; // 1 for PM, 12 hour mode only
+	// local time, decoded
+	uint8_t sec;
+	uint8_t min;
+	uint8_t hour; // 0-23 whatever the mode
+	uint8_t day; // 1-7, Sunday is 1
+	uint8_t date; // 1-31
+	uint8_t month; // 1-12
+	uint8_t year; // 0-99, 2000-2099
+	int8_t temp; // whole degrees C
+	uint8_t temp_age; // seconds since temp was measured, up to TIMESVC_TEMP_OLD
+	uint32_t epoch; // UTC seconds since 2000-01-01 00:00:00
+	int16_t utc_offset; // minutes local time is ahead of UTC
+	uint8_t dst; // 1 in summer time
+	uint8_t a1_count; // counts alarm 1 matches, wraps
+} xTime;
+
+void timesvc_start(unsigned portBASE_TYPE Priority); // reads the DS3231 once and creates the task, call before anything reads the time
+uint8_t timesvc_get(xTime *t); // copies the newest snapshot, returns its generation
+uint8_t timesvc_gen(void); // changes whenever a new snapshot is published
+uint8_t timesvc_a1_count(void); // a1_count of the newest snapshot, without copying it
+int8_t timesvc_temp(uint8_t *age); // temp and temp_age of the newest snapshot, never waits for a conversion
+void timesvc_temp_max_age(uint8_t secs); // a conversion is started whenever the temperature gets this old
+
+void timesvc_set_hour_mode(uint8_t twelve); // 12 or 24 hour hour_bcd in the snapshot
+void timesvc_set_a1(uint8_t day, uint8_t hour, uint8_t min); // local day 1-7, hour 0-23, fires at second 00
+void timesvc_clear_a1(void);
+void timesvc_fire_a1(void); // counts an alarm 1 match now, for an alarm that is already due
+
+#endif
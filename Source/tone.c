@@ -0,0 +1,157 @@
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include "lcd.h"
+#include "tone.h"
+
+#if LCD_TRANSPORT == LCD_TRANSPORT_PARALLEL4
+#error "the buzzer on PD7 (OC2A) is the parallel LCD's R/W line, pick another LCD transport"
+#endif
+
+/* One cycle of each wave, signed */
+const int8_t tone_waves[2][256] PROGMEM = {
+	{ // sine
+		0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+		49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+		90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+		117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+		127, 127, 127, 127, 126, 126, 126, 125, 125, 124, 123, 122, 122, 121, 120, 118,
+		117, 116, 115, 113, 112, 111, 109, 107, 106, 104, 102, 100, 98, 96, 94, 92,
+		90, 88, 85, 83, 81, 78, 76, 73, 71, 68, 65, 63, 60, 57, 54, 51,
+		49, 46, 43, 40, 37, 34, 31, 28, 25, 22, 19, 16, 12, 9, 6, 3,
+		0, -3, -6, -9, -12, -16, -19, -22, -25, -28, -31, -34, -37, -40, -43, -46,
+		-49, -51, -54, -57, -60, -63, -65, -68, -71, -73, -76, -78, -81, -83, -85, -88,
+		-90, -92, -94, -96, -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+		-117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+		-127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+		-117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100, -98, -96, -94, -92,
+		-90, -88, -85, -83, -81, -78, -76, -73, -71, -68, -65, -63, -60, -57, -54, -51,
+		-49, -46, -43, -40, -37, -34, -31, -28, -25, -22, -19, -16, -12, -9, -6, -3
+	},
+	{ // bell: sine with half of the 2nd and a quarter of the 3rd harmonic
+		0, 6, 12, 18, 25, 31, 37, 42, 48, 54, 59, 65, 70, 75, 79, 84,
+		89, 93, 97, 100, 104, 107, 110, 113, 116, 118, 120, 122, 123, 124, 125, 126,
+		127, 127, 127, 127, 126, 126, 125, 124, 123, 122, 120, 118, 117, 115, 113, 110,
+		108, 106, 103, 101, 99, 96, 93, 91, 88, 86, 83, 81, 78, 76, 73, 71,
+		69, 66, 64, 62, 60, 58, 57, 55, 53, 52, 50, 49, 48, 46, 45, 44,
+		43, 43, 42, 41, 40, 40, 39, 39, 38, 38, 37, 37, 37, 36, 36, 36,
+		35, 35, 34, 34, 33, 33, 32, 32, 31, 30, 30, 29, 28, 27, 26, 25,
+		24, 23, 21, 20, 19, 17, 16, 15, 13, 12, 10, 8, 7, 5, 3, 2,
+		0, -2, -3, -5, -7, -8, -10, -12, -13, -15, -16, -17, -19, -20, -21, -23,
+		-24, -25, -26, -27, -28, -29, -30, -30, -31, -32, -32, -33, -33, -34, -34, -35,
+		-35, -36, -36, -36, -37, -37, -37, -38, -38, -39, -39, -40, -40, -41, -42, -43,
+		-43, -44, -45, -46, -48, -49, -50, -52, -53, -55, -57, -58, -60, -62, -64, -66,
+		-69, -71, -73, -76, -78, -81, -83, -86, -88, -91, -93, -96, -99, -101, -103, -106,
+		-108, -110, -113, -115, -117, -118, -120, -122, -123, -124, -125, -126, -126, -127, -127, -127,
+		-127, -126, -125, -124, -123, -122, -120, -118, -116, -113, -110, -107, -104, -100, -97, -93,
+		-89, -84, -79, -75, -70, -65, -59, -54, -48, -42, -37, -31, -25, -18, -12, -6
+	}
+};
+
+const xToneNote tone_wake[] PROGMEM = {
+	{TONE_INC(523), 20, TONE_BELL}, {TONE_INC(659), 20, TONE_BELL}, {TONE_INC(784), 20, TONE_BELL},
+	{TONE_INC(1047), 40, TONE_BELL}, {0, 60, TONE_BELL}, {0, 0, 0}
+};
+
+const xToneNote tone_beep[] PROGMEM = {
+	{TONE_INC(2000), 10, TONE_SINE}, {0, 10, TONE_SINE}, {TONE_INC(2000), 10, TONE_SINE}, {0, 40, TONE_SINE}, {0, 0, 0}
+};
+
+static const xToneNote *tone_melody; // start of the melody playing
+static const xToneNote *tone_note; // next note to load
+static const int8_t *tone_wave;
+static uint16_t tone_phase;
+static uint16_t tone_inc;
+static uint8_t tone_amp; // envelope * volume, what samples are scaled by
+static uint8_t tone_env;
+static uint8_t tone_volume;
+static uint8_t tone_left; // frames left of the note
+static uint8_t tone_ramp;
+static uint8_t tone_sample; // samples into the frame, wraps at 256
+
+void tone_init(void) {
+	DDRD |= 0x80;
+	OCR2A = 128; // silence is the middle
+	TCCR2A = (1 << WGM20); // phase correct PWM, 8 bit, output connected on play
+	TCCR2B = (1 << CS20); // clk / 1
+}
+
+void tone_play(const xToneNote *melody) {
+	uint8_t sreg = SREG;
+	cli();
+	tone_melody = melody;
+	tone_note = melody;
+	tone_inc = 0;
+	tone_amp = 0;
+	tone_left = 0;
+	tone_volume = TONE_VOLUME_START;
+	tone_ramp = TONE_RAMP_FRAMES;
+	tone_sample = 0;
+	tone_wave = tone_waves[0];
+	OCR2A = 128;
+	TCCR2A |= (1 << COM2A1); // non-inverting PWM on PD7
+	TIFR2 = (1 << TOV2);
+	TIMSK2 |= (1 << TOIE2);
+	SREG = sreg;
+}
+
+void tone_stop(void) {
+	uint8_t sreg = SREG;
+	cli();
+	TIMSK2 &= ~(1 << TOIE2);
+	TCCR2A &= ~(1 << COM2A1);
+	PORTD &= 0x7F;
+	tone_melody = 0;
+	SREG = sreg;
+}
+
+uint8_t tone_playing(void) {
+	return (TIMSK2 & (1 << TOIE2)) ? 1 : 0;
+}
+
+/* Once every 256 samples: next note, envelope and volume. */
+static inline void tone_frame(void) {
+	uint8_t frames;
+
+	if(tone_left == 0) {
+		frames = pgm_read_byte(&tone_note->frames);
+		if(frames == 0) { // end, start over
+			tone_note = tone_melody;
+			frames = pgm_read_byte(&tone_note->frames);
+		}
+		tone_inc = pgm_read_word(&tone_note->inc);
+		tone_wave = tone_waves[pgm_read_byte(&tone_note->wave) & 0x01];
+		tone_left = frames;
+		tone_env = 255;
+		tone_note++;
+	}
+	else {
+		tone_env = (tone_env > TONE_DECAY) ? tone_env - TONE_DECAY : 0;
+	}
+	if(tone_left) {
+		tone_left--;
+	}
+
+	if(--tone_ramp == 0) {
+		tone_ramp = TONE_RAMP_FRAMES;
+		if(tone_volume < 255) {
+			tone_volume++;
+		}
+	}
+
+	tone_amp = tone_inc ? ((uint16_t)tone_env * tone_volume) >> 8 : 0;
+}
+
+/* A sample is a 16 bit add, a flash read and one multiply; the frame work
+above runs once per 256 samples. */
+ISR(TIMER2_OVF_vect) {
+	int8_t s;
+
+	tone_phase += tone_inc;
+	s = pgm_read_byte(tone_wave + (tone_phase >> 8));
+	OCR2A = 128 + (int8_t)(((int16_t)s * tone_amp) >> 8);
+
+	if(++tone_sample == 0) {
+		tone_frame();
+	}
+}
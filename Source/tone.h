@@ -0,0 +1,41 @@
+/* Alarm tones, synthesised by Timer2 with no task running */
+#ifndef TONE_H
+#define TONE_H
+
+#include <stdint.h>
+
+#ifndef F_CPU
+#error "F_CPU must be set for the whole build, the tone rate depends on it"
+#endif
+
+// The buzzer is on PD7 (OC2A), driven by 8 bit phase correct PWM at
+// F_CPU / 510 (15.7kHz at 8MHz). Timer2 overflows once a period and every
+// overflow makes a new sample. PD7 is the LCD's R/W line with
+// LCD_TRANSPORT_PARALLEL4, so tones can not be built with that transport.
+#define TONE_RATE (F_CPU / 510) // samples a second
+#define TONE_INC(hz) ((uint16_t)(((hz) * 65536UL) / TONE_RATE)) // phase step for a frequency
+
+// Notes, envelope and volume move on every 256 samples (16ms at 15.7kHz)
+#define TONE_DECAY 3 // envelope lost per frame, a note starts at full and dies away like a bell
+#define TONE_VOLUME_START 24 // master volume when a melody starts
+#define TONE_RAMP_FRAMES 8 // frames per step of master volume, 255 is reached after about 30s
+
+#define TONE_SINE 0
+#define TONE_BELL 1
+
+typedef struct {
+	uint16_t inc; // TONE_INC(hz), 0 for a rest
+	uint8_t frames; // length, 0 ends the melody and it starts over
+	uint8_t wave; // TONE_SINE or TONE_BELL
+} xToneNote;
+
+/* melodies in flash */
+extern const xToneNote tone_wake[];
+extern const xToneNote tone_beep[];
+
+void tone_init(void);
+void tone_play(const xToneNote *melody); // loops until tone_stop, volume ramps up from TONE_VOLUME_START
+void tone_stop(void);
+uint8_t tone_playing(void); // Timer2 has to keep running while this is 1
+
+#endif
@@ -0,0 +1,116 @@
+#include <avr/pgmspace.h>
+#include "calendar.h"
+#include "tz.h"
+
+#define TZ_NEVER 0xFFFFFFFFUL
+
+const xTzRule tz_zones[TZ_COUNT] PROGMEM = {
+	[TZ_UTC] = {0, 0, {0, 0, 0, 0}, {0, 0, 0, 0}}, // UTC0
+	[TZ_US_EASTERN] = {-300, 60, {3, 2, 0, 2}, {11, 1, 0, 2}}, // EST5EDT,M3.2.0,M11.1.0
+	[TZ_US_CENTRAL] = {-360, 60, {3, 2, 0, 2}, {11, 1, 0, 2}}, // CST6CDT,M3.2.0,M11.1.0
+	[TZ_US_MOUNTAIN] = {-420, 60, {3, 2, 0, 2}, {11, 1, 0, 2}}, // MST7MDT,M3.2.0,M11.1.0
+	[TZ_US_ARIZONA] = {-420, 0, {0, 0, 0, 0}, {0, 0, 0, 0}}, // MST7
+	[TZ_US_PACIFIC] = {-480, 60, {3, 2, 0, 2}, {11, 1, 0, 2}}, // PST8PDT,M3.2.0,M11.1.0
+	[TZ_UK] = {0, 60, {3, 5, 0, 1}, {10, 5, 0, 2}}, // GMT0BST,M3.5.0/1,M10.5.0
+	[TZ_CENTRAL_EUROPE] = {60, 60, {3, 5, 0, 2}, {10, 5, 0, 3}}, // CET-1CEST,M3.5.0,M10.5.0/3
+	[TZ_AU_SYDNEY] = {600, 60, {10, 1, 0, 2}, {4, 1, 0, 3}} // AEST-10AEDT,M10.1.0,M4.1.0/3
+};
+
+static xTzRule tz_rule; // copied out of flash by tz_select
+static uint8_t tz_valid = 0; // tz_from, tz_until and tz_off hold
+static uint32_t tz_from; // the cached offset holds from here
+static uint32_t tz_until; // up to here, the next change
+static int16_t tz_off;
+static uint8_t tz_summer;
+
+void tz_select(uint8_t zone) {
+	if(zone >= TZ_COUNT) {
+		zone = TZ_UTC;
+	}
+	memcpy_P(&tz_rule, &tz_zones[zone], sizeof(xTzRule));
+	tz_valid = 0;
+}
+
+/* UTC of a change in year y, offset is what local time is ahead of UTC just
+before it. */
+static uint32_t tz_change(uint8_t y, const xTzWhen *w, int16_t offset) {
+	uint8_t first, date, len;
+
+	first = cal_dow(y, w->month, 1) - CAL_SUNDAY; // 0 Sunday
+	date = 1 + ((w->dow + 7 - first) % 7) + 7 * (w->week - 1);
+	len = cal_month_len(y, w->month);
+	while(date > len) { // week 5, the last one
+		date -= 7;
+	}
+	return (uint32_t)cal_days(y, w->month, date) * 86400UL + (uint16_t)w->hour * 3600U - (int32_t)offset * 60;
+}
+
+/* Works out the offset at utc and when it next changes. Only runs when
+utc leaves the cached range, so twice a year. */
+static void tz_update(uint32_t utc) {
+	xCalTime c;
+	uint32_t start, end;
+	int16_t summer = tz_rule.std_offset + tz_rule.dst_offset;
+
+	tz_valid = 1;
+	tz_from = utc;
+	if(tz_rule.dst_offset == 0) {
+		tz_off = tz_rule.std_offset;
+		tz_summer = 0;
+		tz_until = TZ_NEVER;
+		return;
+	}
+
+	cal_from_epoch(utc, &c);
+	start = tz_change(c.year, &tz_rule.start, tz_rule.std_offset);
+	end = tz_change(c.year, &tz_rule.end, summer);
+
+	if(start < end) { // northern, summer in the middle of the year
+		tz_summer = (utc >= start && utc < end);
+		if(utc < start) {
+			tz_until = start;
+		}
+		else if(utc < end) {
+			tz_until = end;
+		}
+		else {
+			tz_until = (c.year < 99) ? tz_change(c.year + 1, &tz_rule.start, tz_rule.std_offset) : TZ_NEVER;
+		}
+	}
+	else { // southern, summer over the new year
+		tz_summer = (utc < end || utc >= start);
+		if(utc < end) {
+			tz_until = end;
+		}
+		else if(utc < start) {
+			tz_until = start;
+		}
+		else {
+			tz_until = (c.year < 99) ? tz_change(c.year + 1, &tz_rule.end, summer) : TZ_NEVER;
+		}
+	}
+	tz_off = tz_summer ? summer : tz_rule.std_offset;
+}
+
+uint32_t tz_local(uint32_t utc) {
+	// one unsigned compare covers both ends of [tz_from, tz_until)
+	if(!tz_valid || utc - tz_from >= tz_until - tz_from) {
+		tz_update(utc);
+	}
+	if(tz_off < 0 && utc < (uint32_t)(-tz_off) * 60) {
+		return 0; // before 2000 locally, the calendar stops there
+	}
+	return utc + (int32_t)tz_off * 60;
+}
+
+int16_t tz_offset(void) {
+	return tz_off;
+}
+
+uint8_t tz_dst(void) {
+	return tz_summer;
+}
+
+uint32_t tz_next(void) {
+	return tz_until;
+}
@@ -0,0 +1,49 @@
+/* Time zones. The DS3231 keeps UTC and local time is worked out from a rule
+table in flash, in the spirit of a POSIX TZ string such as
+"PST8PDT,M3.2.0,M11.1.0". The offset is cached together with the UTC time
+of the next change, so converting is a compare and an add until then. */
+#ifndef TZ_H
+#define TZ_H
+
+#include <stdint.h>
+
+// when a change happens, like Mm.w.d/h in a TZ string
+typedef struct {
+	uint8_t month; // 1-12
+	uint8_t week; // 1-4, 5 is the last one in the month
+	uint8_t dow; // 0 Sunday - 6 Saturday
+	uint8_t hour; // local time the change happens at, as it reads before the change
+} xTzWhen;
+
+typedef struct {
+	int16_t std_offset; // minutes east of UTC in winter, the opposite sign to TZ strings
+	uint8_t dst_offset; // minutes added in summer, 0 if the zone has no DST
+	xTzWhen start; // into summer time
+	xTzWhen end; // back to standard time
+} xTzRule;
+
+// zones in tz_zones
+#define TZ_UTC 0
+#define TZ_US_EASTERN 1
+#define TZ_US_CENTRAL 2
+#define TZ_US_MOUNTAIN 3
+#define TZ_US_ARIZONA 4
+#define TZ_US_PACIFIC 5
+#define TZ_UK 6
+#define TZ_CENTRAL_EUROPE 7
+#define TZ_AU_SYDNEY 8
+#define TZ_COUNT 9
+
+#ifndef TZ_ZONE
+#define TZ_ZONE TZ_US_PACIFIC
+#endif
+
+extern const xTzRule tz_zones[TZ_COUNT];
+
+void tz_select(uint8_t zone); // drops the cached offset
+uint32_t tz_local(uint32_t utc); // local seconds since 2000 for utc seconds since 2000
+int16_t tz_offset(void); // minutes, as used by the last tz_local
+uint8_t tz_dst(void); // 1 if the last tz_local was in summer time
+uint32_t tz_next(void); // UTC of the next change after the last tz_local, 0xFFFFFFFF if none
+
+#endif